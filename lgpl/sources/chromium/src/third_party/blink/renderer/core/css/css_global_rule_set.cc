@@ -34,6 +34,7 @@ void CSSGlobalRuleSet::Update(Document& document) {
     return;
 
   is_dirty_ = false;
+  stale_rule_count_ = 0;
   features_.Clear();
   has_fullscreen_ua_style_ = false;
 
@@ -53,11 +54,27 @@ void CSSGlobalRuleSet::Update(Document& document) {
   document.GetStyleEngine().CollectFeaturesTo(features_);
 }
 
+void CSSGlobalRuleSet::AddAppendedFeatures(const RuleFeatureSet& features) {
+  // A dirty rule set collects the appended features in Update().
+  if (is_dirty_)
+    return;
+  features_.Add(features);
+}
+
+void CSSGlobalRuleSet::RemovedRuleSets(unsigned rule_count) {
+  if (is_dirty_)
+    return;
+  stale_rule_count_ += rule_count;
+  if (stale_rule_count_ > kMaxStaleRuleCount)
+    MarkDirty();
+}
+
 void CSSGlobalRuleSet::Dispose() {
   features_.Clear();
   watched_selectors_rule_set_ = nullptr;
   has_fullscreen_ua_style_ = false;
   is_dirty_ = true;
+  stale_rule_count_ = 0;
 }
 
 void CSSGlobalRuleSet::Trace(blink::Visitor* visitor) {
@@ -32,6 +32,17 @@ class CSSGlobalRuleSet final : public GarbageCollected<CSSGlobalRuleSet> {
   bool IsDirty() const { return is_dirty_; }
   void Update(Document&);
 
+  // Merges the features of sheets appended to a TreeScope instead of
+  // re-collecting the features of all active sheets in Update().
+  void AddAppendedFeatures(const RuleFeatureSet&);
+
+  // The features of removed sheets are left in the aggregated features, which
+  // may only cause unnecessary invalidations. They are dropped by a full
+  // Update() once the removed sheets had more than kMaxStaleRuleCount rules.
+  void RemovedRuleSets(unsigned rule_count);
+
+  static constexpr unsigned kMaxStaleRuleCount = 1000;
+
   const RuleFeatureSet& GetRuleFeatureSet() const {
     CHECK(features_.IsAlive());
     return features_;
@@ -53,6 +64,8 @@ class CSSGlobalRuleSet final : public GarbageCollected<CSSGlobalRuleSet> {
 
   bool has_fullscreen_ua_style_ = false;
   bool is_dirty_ = true;
+  // The number of rules in removed sheets since the last full Update().
+  unsigned stale_rule_count_ = 0;
   DISALLOW_COPY_AND_ASSIGN(CSSGlobalRuleSet);
 };
 
@@ -141,17 +141,17 @@ void ElementRuleCollector::CollectMatchingRulesForList(
   for (const auto& rule_data : *rules) {
     if (can_use_fast_reject_ &&
         selector_filter_.FastRejectSelector<RuleData::kMaximumIdentifierCount>(
-            rule_data->DescendantSelectorIdentifierHashes())) {
+            rule_data.DescendantSelectorIdentifierHashes())) {
       fast_rejected++;
       continue;
     }
 
     // Don't return cross-origin rules if we did not explicitly ask for them
     // through SetSameOriginOnly.
-    if (same_origin_only_ && !rule_data->HasDocumentSecurityOrigin())
+    if (same_origin_only_ && !rule_data.HasDocumentSecurityOrigin())
       continue;
 
-    StyleRule* rule = rule_data->Rule();
+    StyleRule* rule = rule_data.Rule();
 
     // If the rule has no properties to apply, then ignore it in the non-debug
     // mode.
@@ -159,7 +159,7 @@ void ElementRuleCollector::CollectMatchingRulesForList(
       continue;
 
     SelectorChecker::MatchResult result;
-    context.selector = &rule_data->Selector();
+    context.selector = &rule_data.Selector();
     if (!checker.Match(context, result)) {
       rejected++;
       continue;
@@ -171,7 +171,7 @@ void ElementRuleCollector::CollectMatchingRulesForList(
     }
 
     matched++;
-    DidMatchRule(rule_data, result, cascade_order, match_request);
+    DidMatchRule(&rule_data, result, cascade_order, match_request);
   }
 
   StyleEngine& style_engine =
@@ -77,11 +77,14 @@ class MatchedRule {
   const CSSStyleSheet* ParentStyleSheet() const { return parent_style_sheet_; }
   void Trace(blink::Visitor* visitor) {
     visitor->Trace(parent_style_sheet_);
-    visitor->Trace(rule_data_);
   }
 
  private:
-  Member<const RuleData> rule_data_;
+  // The RuleData is stored inline in the backing of a RuleSet bucket. The
+  // RuleSet is kept alive by the MatchRequest for as long as the
+  // ElementRuleCollector exists, and no GC (hence no compaction of the
+  // backing) can happen during rule matching.
+  const RuleData* rule_data_;
   unsigned specificity_;
   uint64_t position_;
   Member<const CSSStyleSheet> parent_style_sheet_;
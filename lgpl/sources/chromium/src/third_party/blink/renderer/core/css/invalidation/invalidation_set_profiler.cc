@@ -0,0 +1,151 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/css/invalidation/invalidation_set_profiler.h"
+
+#include <algorithm>
+
+#include "third_party/blink/renderer/core/css/invalidation/invalidation_set.h"
+#include "third_party/blink/renderer/core/dom/element.h"
+#include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
+#include "third_party/blink/renderer/platform/instrumentation/tracing/traced_value.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
+
+namespace blink {
+
+namespace {
+
+String InvalidationSetDescription(const InvalidationSet& invalidation_set) {
+  auto value = std::make_unique<TracedValue>();
+  value->BeginArray("set");
+  invalidation_set.ToTracedValue(value.get());
+  value->EndArray();
+  return value->ToString();
+}
+
+}  // namespace
+
+void InvalidationSetProfiler::Counts::Add(const Counts& other) {
+  elements_tested += other.elements_tested;
+  elements_invalidated += other.elements_invalidated;
+  styles_changed += other.styles_changed;
+}
+
+bool InvalidationSetProfiler::IsEnabled() {
+  if (RuntimeEnabledFeatures::InvalidationSetProfilingEnabled())
+    return true;
+  bool tracing_enabled;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(
+      TRACE_DISABLED_BY_DEFAULT("blink.invalidation_cost"), &tracing_enabled);
+  return tracing_enabled;
+}
+
+InvalidationSetProfiler::Counts& InvalidationSetProfiler::EnsureCounts(
+    EntryMap& entries,
+    const InvalidationSet& invalidation_set) {
+  auto result = entries.insert(&invalidation_set, Entry());
+  if (result.is_new_entry)
+    result.stored_value->value.invalidation_set = &invalidation_set;
+  return result.stored_value->value.counts;
+}
+
+void InvalidationSetProfiler::DidTestElement(
+    const InvalidationSet& invalidation_set,
+    Element& element,
+    bool invalidated) {
+  Counts& counts = EnsureCounts(update_entries_, invalidation_set);
+  counts.elements_tested++;
+  if (!invalidated)
+    return;
+  // An element may be tested against several sets, or visited again through
+  // slot distribution. Attribute it to the first set which invalidated it.
+  if (pending_elements_.insert(&element, &invalidation_set).is_new_entry)
+    counts.elements_invalidated++;
+}
+
+void InvalidationSetProfiler::DidRecalcStyle(Element& element,
+                                             bool style_changed) {
+  auto it = pending_elements_.find(&element);
+  if (it == pending_elements_.end())
+    return;
+  const InvalidationSet* invalidation_set = it->value;
+  pending_elements_.erase(it);
+  if (style_changed)
+    EnsureCounts(update_entries_, *invalidation_set).styles_changed++;
+}
+
+void InvalidationSetProfiler::DidUpdateStyle() {
+  // Elements which were invalidated but skipped by style recalc, e.g. in
+  // display:none subtrees, count as unchanged.
+  pending_elements_.clear();
+  if (update_entries_.IsEmpty())
+    return;
+
+  TRACE_EVENT_INSTANT1(TRACE_DISABLED_BY_DEFAULT("blink.invalidation_cost"),
+                       "InvalidationSetCost", TRACE_EVENT_SCOPE_THREAD, "data",
+                       ToTracedValue(update_entries_));
+
+  for (const auto& entry : update_entries_) {
+    EnsureCounts(summary_entries_, *entry.key).Add(entry.value.counts);
+  }
+  update_entries_.clear();
+}
+
+const InvalidationSetProfiler::Counts* InvalidationSetProfiler::SummaryFor(
+    const InvalidationSet& invalidation_set) const {
+  auto it = summary_entries_.find(&invalidation_set);
+  if (it == summary_entries_.end())
+    return nullptr;
+  return &it->value.counts;
+}
+
+std::unique_ptr<TracedValue> InvalidationSetProfiler::ToTracedValue(
+    const EntryMap& entries) {
+  auto value = std::make_unique<TracedValue>();
+  value->BeginArray("invalidationSets");
+  for (const auto& entry : entries) {
+    const Counts& counts = entry.value.counts;
+    value->BeginDictionary();
+    value->SetInteger("elementsTested", counts.elements_tested);
+    value->SetInteger("elementsInvalidated", counts.elements_invalidated);
+    value->SetInteger("stylesChanged", counts.styles_changed);
+    value->BeginArray("invalidationSet");
+    entry.key->ToTracedValue(value.get());
+    value->EndArray();
+    value->EndDictionary();
+  }
+  value->EndArray();
+  return value;
+}
+
+String InvalidationSetProfiler::Report(wtf_size_t max_entries) const {
+  Vector<const Entry*> sorted_entries;
+  for (const auto& entry : summary_entries_)
+    sorted_entries.push_back(&entry.value);
+  std::sort(sorted_entries.begin(), sorted_entries.end(),
+            [](const Entry* a, const Entry* b) {
+              return a->counts.elements_invalidated >
+                     b->counts.elements_invalidated;
+            });
+
+  StringBuilder builder;
+  builder.Append("Invalidated  Changed  Tested  Invalidation set\n");
+  for (wtf_size_t i = 0; i < sorted_entries.size() && i < max_entries; ++i) {
+    const Entry& entry = *sorted_entries[i];
+    builder.Append(String::Format("%11u  %7u  %6u  ",
+                                  entry.counts.elements_invalidated,
+                                  entry.counts.styles_changed,
+                                  entry.counts.elements_tested));
+    builder.Append(InvalidationSetDescription(*entry.invalidation_set));
+    builder.Append('\n');
+  }
+  return builder.ToString();
+}
+
+void InvalidationSetProfiler::Trace(blink::Visitor* visitor) {
+  visitor->Trace(pending_elements_);
+}
+
+}  // namespace blink
@@ -0,0 +1,100 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_CSS_INVALIDATION_INVALIDATION_SET_PROFILER_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_CSS_INVALIDATION_INVALIDATION_SET_PROFILER_H_
+
+#include <memory>
+
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/platform/heap/handle.h"
+#include "third_party/blink/renderer/platform/wtf/hash_map.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
+
+namespace blink {
+
+class Element;
+class InvalidationSet;
+class TracedValue;
+
+// Attributes the cost of style invalidation to the InvalidationSets which
+// caused it. For every set, counts the elements the StyleInvalidator tested
+// against it, the elements it marked for style recalc, and how many of those
+// ended up with a different ComputedStyle. Sets with many invalidated but few
+// changed elements point at the selectors which make class toggles and
+// similar mutations expensive.
+//
+// The counts for each style update are emitted as an "InvalidationSetCost"
+// trace event in the disabled-by-default "blink.invalidation_cost" category,
+// and are accumulated into a summary which can be dumped with Report().
+class CORE_EXPORT InvalidationSetProfiler final
+    : public GarbageCollected<InvalidationSetProfiler> {
+ public:
+  struct Counts {
+    unsigned elements_tested = 0;
+    unsigned elements_invalidated = 0;
+    unsigned styles_changed = 0;
+
+    void Add(const Counts&);
+  };
+
+  // Returns true if profiling is enabled either through the runtime flag or
+  // the tracing category.
+  static bool IsEnabled();
+
+  InvalidationSetProfiler() = default;
+
+  // Called by the StyleInvalidator for every element tested against
+  // |invalidation_set|. The first set which invalidates an element is the one
+  // the resulting style recalc is attributed to.
+  void DidTestElement(const InvalidationSet& invalidation_set,
+                      Element&,
+                      bool invalidated);
+
+  // Called when style was recalculated for an element.
+  void DidRecalcStyle(Element&, bool style_changed);
+
+  // Emits the trace event for the current style update and folds its counts
+  // into the summary.
+  void DidUpdateStyle();
+
+  // Returns the counts accumulated for |invalidation_set| by finished style
+  // updates, or nullptr if the set never tested an element.
+  const Counts* SummaryFor(const InvalidationSet& invalidation_set) const;
+
+  // Returns a human readable summary of the sets which invalidated the most
+  // elements, at most |max_entries| of them.
+  String Report(wtf_size_t max_entries = 20) const;
+
+  void Trace(blink::Visitor*);
+
+ private:
+  struct Entry {
+    DISALLOW_NEW();
+    // Keeps the set alive so that its address is not reused for another set
+    // while profiling.
+    scoped_refptr<const InvalidationSet> invalidation_set;
+    Counts counts;
+  };
+  using EntryMap = HashMap<const InvalidationSet*, Entry>;
+
+  static Counts& EnsureCounts(EntryMap&, const InvalidationSet&);
+  static std::unique_ptr<TracedValue> ToTracedValue(const EntryMap&);
+
+  // Counts for the current style update.
+  EntryMap update_entries_;
+  // Counts for all finished style updates.
+  EntryMap summary_entries_;
+  // Elements marked for style recalc by the invalidator which have not been
+  // recalculated yet, with the set they are attributed to.
+  HeapHashMap<WeakMember<Element>, const InvalidationSet*> pending_elements_;
+
+  DISALLOW_COPY_AND_ASSIGN(InvalidationSetProfiler);
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_CSS_INVALIDATION_INVALIDATION_SET_PROFILER_H_
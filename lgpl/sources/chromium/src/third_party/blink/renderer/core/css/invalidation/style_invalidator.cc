@@ -5,6 +5,7 @@
 #include "third_party/blink/renderer/core/css/invalidation/style_invalidator.h"
 
 #include "third_party/blink/renderer/core/css/invalidation/invalidation_set.h"
+#include "third_party/blink/renderer/core/css/invalidation/invalidation_set_profiler.h"
 #include "third_party/blink/renderer/core/css/style_change_reason.h"
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/dom/element.h"
@@ -58,8 +59,10 @@ void StyleInvalidator::Invalidate(Document& document, Element* root_element) {
 }
 
 StyleInvalidator::StyleInvalidator(
-    PendingInvalidationMap& pending_invalidation_map)
-    : pending_invalidation_map_(pending_invalidation_map) {
+    PendingInvalidationMap& pending_invalidation_map,
+    InvalidationSetProfiler* profiler)
+    : pending_invalidation_map_(pending_invalidation_map),
+      profiler_(profiler) {
   g_style_invalidator_tracing_enabled =
       TRACE_EVENT_API_GET_CATEGORY_GROUP_ENABLED(
           TRACE_DISABLED_BY_DEFAULT("devtools.timeline.invalidationTracking"));
@@ -98,6 +101,9 @@ ALWAYS_INLINE bool StyleInvalidator::MatchesCurrentInvalidationSets(
       element.IsV0InsertionPoint())
     return true;
 
+  if (UNLIKELY(profiler_))
+    return MatchesCurrentInvalidationSetsWithProfiler(element);
+
   for (auto* const invalidation_set : invalidation_sets_) {
     if (invalidation_set->InvalidatesElement(element))
       return true;
@@ -106,6 +112,18 @@ ALWAYS_INLINE bool StyleInvalidator::MatchesCurrentInvalidationSets(
   return false;
 }
 
+bool StyleInvalidator::MatchesCurrentInvalidationSetsWithProfiler(
+    Element& element) const {
+  DCHECK(profiler_);
+  for (auto* const invalidation_set : invalidation_sets_) {
+    bool invalidated = invalidation_set->InvalidatesElement(element);
+    profiler_->DidTestElement(*invalidation_set, element, invalidated);
+    if (invalidated)
+      return true;
+  }
+  return false;
+}
+
 bool StyleInvalidator::MatchesCurrentInvalidationSetsAsSlotted(
     Element& element) const {
   DCHECK(invalidation_flags_.InvalidatesSlotted());
@@ -162,7 +180,13 @@ bool StyleInvalidator::SiblingData::MatchCurrentInvalidationSets(
     const SiblingInvalidationSet& invalidation_set =
         *invalidation_entries_[index].invalidation_set_;
     ++index;
-    if (!invalidation_set.InvalidatesElement(element))
+    bool invalidated = invalidation_set.InvalidatesElement(element);
+    if (UNLIKELY(style_invalidator.profiler_)) {
+      style_invalidator.profiler_->DidTestElement(
+          invalidation_set, element,
+          invalidated && invalidation_set.InvalidatesSelf());
+    }
+    if (!invalidated)
       continue;
 
     if (invalidation_set.InvalidatesSelf())
@@ -17,6 +17,7 @@ class ContainerNode;
 class Element;
 class HTMLSlotElement;
 class InvalidationSet;
+class InvalidationSetProfiler;
 
 // Applies deferred style invalidation for DOM subtrees.
 //
@@ -26,7 +27,10 @@ class CORE_EXPORT StyleInvalidator {
   STACK_ALLOCATED();
 
  public:
-  StyleInvalidator(PendingInvalidationMap&);
+  // If |profiler| is non-null, the elements tested and invalidated by each
+  // invalidation set are recorded to it.
+  StyleInvalidator(PendingInvalidationMap&,
+                   InvalidationSetProfiler* profiler = nullptr);
 
   ~StyleInvalidator();
   void Invalidate(Document& document, Element* invalidation_root);
@@ -49,6 +53,7 @@ class CORE_EXPORT StyleInvalidator {
   bool CheckInvalidationSetsAgainstElement(Element&, SiblingData&);
 
   bool MatchesCurrentInvalidationSets(Element&) const;
+  bool MatchesCurrentInvalidationSetsWithProfiler(Element&) const;
   bool MatchesCurrentInvalidationSetsAsSlotted(Element&) const;
   bool MatchesCurrentInvalidationSetsAsParts(Element&) const;
 
@@ -93,6 +98,7 @@ class CORE_EXPORT StyleInvalidator {
   // See the NthSiblingInvalidationSet documentation.
   Vector<const NthSiblingInvalidationSet*> pending_nth_sets_;
   InvalidationFlags invalidation_flags_;
+  InvalidationSetProfiler* profiler_;
 
   class SiblingData {
     STACK_ALLOCATED();
@@ -5,10 +5,14 @@
 #include "third_party/blink/renderer/core/css/invalidation/style_invalidator.h"
 
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/core/css/invalidation/invalidation_set_profiler.h"
+#include "third_party/blink/renderer/core/css/rule_feature_set.h"
 #include "third_party/blink/renderer/core/css/style_engine.h"
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/html/html_element.h"
+#include "third_party/blink/renderer/core/html_names.h"
 #include "third_party/blink/renderer/core/testing/dummy_page_holder.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
 
 namespace blink {
 
@@ -94,4 +98,54 @@ TEST_F(StyleInvalidatorTest, SkipDisplayNoneClearPendingNth) {
       GetDocument().getElementById("descendant")->ChildNeedsStyleRecalc());
 }
 
+TEST_F(StyleInvalidatorTest, ProfileInvalidationSetCost) {
+  ScopedInvalidationSetProfilingForTest scoped_feature(true);
+
+  GetDocument().body()->SetInnerHTMLFromString(R"HTML(
+    <style>
+      .a .b { color: green }
+      .a .c { color: initial }
+    </style>
+    <div id="root">
+      <div class="b"></div>
+      <div class="b"></div>
+      <div class="c"></div>
+      <span></span>
+    </div>
+  )HTML");
+
+  GetDocument().View()->UpdateAllLifecyclePhases(
+      DocumentLifecycle::LifecycleUpdateReason::kTest);
+
+  InvalidationSetProfiler* profiler =
+      GetDocument().GetStyleEngine().GetInvalidationSetProfiler();
+  ASSERT_TRUE(profiler);
+
+  Element* root = GetDocument().getElementById("root");
+  InvalidationLists lists;
+  const RuleFeatureSet& features =
+      GetDocument().GetStyleEngine().GetRuleFeatureSet();
+  features.CollectInvalidationSetsForClass(lists, *root, "a");
+  ASSERT_EQ(1u, lists.descendants.size());
+  const InvalidationSet& invalidation_set = *lists.descendants[0];
+  EXPECT_FALSE(profiler->SummaryFor(invalidation_set));
+
+  root->setAttribute(html_names::kClassAttr, "a");
+  GetDocument().View()->UpdateAllLifecyclePhases(
+      DocumentLifecycle::LifecycleUpdateReason::kTest);
+
+  // All four children are tested, the .b and .c elements are invalidated,
+  // and only the .b elements get a different color.
+  const InvalidationSetProfiler::Counts* counts =
+      profiler->SummaryFor(invalidation_set);
+  ASSERT_TRUE(counts);
+  EXPECT_EQ(4u, counts->elements_tested);
+  EXPECT_EQ(3u, counts->elements_invalidated);
+  EXPECT_EQ(2u, counts->styles_changed);
+  EXPECT_TRUE(profiler->Report().Contains("\"classes\""));
+
+  GetDocument().GetStyleEngine().SetInvalidationSetProfilingEnabled(false);
+  EXPECT_FALSE(GetDocument().GetStyleEngine().GetInvalidationSetProfiler());
+}
+
 }  // namespace blink
@@ -0,0 +1,57 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/css/parser/css_block_skip_index.h"
+
+#include <algorithm>
+
+#include "base/memory/ptr_util.h"
+#include "third_party/blink/renderer/core/css/parser/css_tokenizer.h"
+
+namespace blink {
+
+std::unique_ptr<CSSBlockSkipIndex> CSSBlockSkipIndex::Create(
+    const String& sheet_text) {
+  auto index = base::WrapUnique(new CSSBlockSkipIndex(sheet_text.length()));
+
+  CSSTokenizer tokenizer(sheet_text);
+  // The tokenizer only reports a block end for the token matching the
+  // innermost open block, so this mirrors what CSSParserTokenStream sees.
+  // Blocks are added when they are opened to keep |blocks_| sorted.
+  Vector<wtf_size_t, 16> open_blocks;
+  while (true) {
+    const CSSParserToken token = tokenizer.TokenizeSingle();
+    if (token.IsEOF())
+      break;
+    if (token.GetBlockType() == CSSParserToken::kBlockStart) {
+      if (token.GetType() == kLeftBraceToken) {
+        open_blocks.push_back(index->blocks_.size());
+        index->blocks_.push_back(std::make_pair(tokenizer.Offset(), 0u));
+      } else {
+        open_blocks.push_back(kNotFound);
+      }
+    } else if (token.GetBlockType() == CSSParserToken::kBlockEnd) {
+      DCHECK(!open_blocks.IsEmpty());
+      wtf_size_t block = open_blocks.back();
+      open_blocks.pop_back();
+      if (block != kNotFound)
+        index->blocks_[block].second = tokenizer.PreviousOffset();
+    }
+  }
+  return index;
+}
+
+wtf_size_t CSSBlockSkipIndex::FindBlockEnd(
+    wtf_size_t block_start_offset) const {
+  auto* it = std::lower_bound(
+      blocks_.begin(), blocks_.end(), block_start_offset,
+      [](const std::pair<wtf_size_t, wtf_size_t>& block, wtf_size_t offset) {
+        return block.first < offset;
+      });
+  if (it == blocks_.end() || it->first != block_start_offset)
+    return 0;
+  return it->second;
+}
+
+}  // namespace blink
@@ -0,0 +1,64 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_CSS_PARSER_CSS_BLOCK_SKIP_INDEX_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_CSS_PARSER_CSS_BLOCK_SKIP_INDEX_H_
+
+#include <memory>
+#include <utility>
+
+#include "base/macros.h"
+#include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace blink {
+
+// Maps the start of every {}-block in a style sheet to the offset of the
+// token which ends it, so that the parser can skip the contents of blocks it
+// parses lazily without tokenizing them.
+//
+// The index only holds offsets, so it can be built on a worker thread from an
+// isolated copy of the sheet text and handed over to the main thread, see
+// CSSStyleSheetResource.
+class CORE_EXPORT CSSBlockSkipIndex {
+  USING_FAST_MALLOC(CSSBlockSkipIndex);
+
+ public:
+  static std::unique_ptr<CSSBlockSkipIndex> Create(const String& sheet_text);
+
+  // Returns the offset of the '}' ending the block whose contents start at
+  // |block_start_offset|, i.e. the offset just after the '{'. Returns 0 if
+  // there is no such block, or if it is not closed.
+  wtf_size_t FindBlockEnd(wtf_size_t block_start_offset) const;
+
+  wtf_size_t TextLength() const { return text_length_; }
+  wtf_size_t size() const { return blocks_.size(); }
+
+  // The text the index was built from. An index built on a worker thread only
+  // saw an isolated copy, so the owner sets this once the index is back on
+  // the main thread.
+  void SetSourceText(const String& sheet_text) {
+    DCHECK_EQ(sheet_text.length(), text_length_);
+    source_text_ = sheet_text;
+  }
+  bool IsFor(const String& sheet_text) const {
+    return !sheet_text.IsNull() && sheet_text.Impl() == source_text_.Impl();
+  }
+
+ private:
+  explicit CSSBlockSkipIndex(wtf_size_t text_length)
+      : text_length_(text_length) {}
+
+  const wtf_size_t text_length_;
+  String source_text_;
+  // Pairs of (block start offset, block end offset), sorted by start offset.
+  Vector<std::pair<wtf_size_t, wtf_size_t>> blocks_;
+  DISALLOW_COPY_AND_ASSIGN(CSSBlockSkipIndex);
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_CSS_PARSER_CSS_BLOCK_SKIP_INDEX_H_
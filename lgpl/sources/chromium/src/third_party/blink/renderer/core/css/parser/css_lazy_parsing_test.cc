@@ -4,6 +4,7 @@
 
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/renderer/core/css/css_style_sheet.h"
+#include "third_party/blink/renderer/core/css/parser/css_block_skip_index.h"
 #include "third_party/blink/renderer/core/css/parser/css_lazy_parsing_state.h"
 #include "third_party/blink/renderer/core/css/parser/css_parser.h"
 #include "third_party/blink/renderer/core/css/parser/css_parser_context.h"
@@ -171,4 +172,66 @@ TEST_F(CSSLazyParsingTest, ChangeDocuments) {
                              UseCounterHelper::CSSPropertyType::kDefault));
 }
 
+TEST_F(CSSLazyParsingTest, BlockSkipIndex) {
+  auto* context = MakeGarbageCollected<CSSParserContext>(
+      kHTMLStandardMode, SecureContextMode::kInsecureContext);
+
+  // The '{' in the url token and the '}' in the parenthesis don't start or
+  // end blocks, the last block is never closed.
+  String sheet_text =
+      "a { color: red; background: url(x{y) } "
+      "@media screen { b { width: calc((1px + 2px)); x: (}) } } "
+      "c { color: green } "
+      "d { color: blue";
+  std::unique_ptr<CSSBlockSkipIndex> index =
+      CSSBlockSkipIndex::Create(sheet_text);
+  EXPECT_EQ(sheet_text.length(), index->TextLength());
+  EXPECT_EQ(5u, index->size());
+  wtf_size_t a_block = sheet_text.find('{') + 1;
+  EXPECT_EQ(sheet_text.find(") }") + 2, index->FindBlockEnd(a_block));
+  EXPECT_EQ(0u, index->FindBlockEnd(a_block + 1));
+  EXPECT_EQ(0u, index->FindBlockEnd(sheet_text.find("d {") + 3));
+
+  auto* style_sheet = MakeGarbageCollected<StyleSheetContents>(context);
+  CSSParser::ParseSheet(context, style_sheet, sheet_text,
+                        CSSDeferPropertyParsing::kYes);
+  auto* skipped_style_sheet = MakeGarbageCollected<StyleSheetContents>(context);
+  CSSParser::ParseSheet(context, skipped_style_sheet, sheet_text,
+                        CSSDeferPropertyParsing::kYes,
+                        true /* allow_import_rules */, index.get());
+
+  ASSERT_EQ(4u, style_sheet->ChildRules().size());
+  ASSERT_EQ(4u, skipped_style_sheet->ChildRules().size());
+  EXPECT_FALSE(HasParsedProperties(RuleAt(skipped_style_sheet, 0)));
+  for (wtf_size_t i : {0, 2, 3}) {
+    EXPECT_EQ(RuleAt(style_sheet, i)->Properties().AsText(),
+              RuleAt(skipped_style_sheet, i)->Properties().AsText());
+  }
+  auto* media = To<StyleRuleMedia>(style_sheet->ChildRules()[1].Get());
+  auto* skipped_media =
+      To<StyleRuleMedia>(skipped_style_sheet->ChildRules()[1].Get());
+  ASSERT_EQ(1u, skipped_media->ChildRules().size());
+  EXPECT_EQ(To<StyleRule>(media->ChildRules()[0].Get())->Properties().AsText(),
+            To<StyleRule>(skipped_media->ChildRules()[0].Get())
+                ->Properties()
+                .AsText());
+}
+
+TEST_F(CSSLazyParsingTest, BlockSkipIndexSourceText) {
+  String sheet_text = "a { color: red } b { color: green }";
+  std::unique_ptr<CSSBlockSkipIndex> index =
+      CSSBlockSkipIndex::Create(sheet_text.IsolatedCopy());
+  EXPECT_FALSE(index->IsFor(sheet_text));
+  index->SetSourceText(sheet_text);
+  EXPECT_TRUE(index->IsFor(sheet_text));
+
+  // Text of the same length, or even with the same contents, is not the text
+  // the offsets were computed for.
+  String other_text = "a { color: red } b { color: gray! }";
+  ASSERT_EQ(sheet_text.length(), other_text.length());
+  EXPECT_FALSE(index->IsFor(other_text));
+  EXPECT_FALSE(index->IsFor(sheet_text.IsolatedCopy()));
+  EXPECT_FALSE(index->IsFor(String()));
+}
+
 }  // namespace blink
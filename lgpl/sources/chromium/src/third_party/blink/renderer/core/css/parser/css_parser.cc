@@ -72,9 +72,11 @@ ParseSheetResult CSSParser::ParseSheet(
     StyleSheetContents* style_sheet,
     const String& text,
     CSSDeferPropertyParsing defer_property_parsing,
-    bool allow_import_rules) {
-  return CSSParserImpl::ParseStyleSheet(
-      text, context, style_sheet, defer_property_parsing, allow_import_rules);
+    bool allow_import_rules,
+    const CSSBlockSkipIndex* block_skip_index) {
+  return CSSParserImpl::ParseStyleSheet(text, context, style_sheet,
+                                        defer_property_parsing,
+                                        allow_import_rules, block_skip_index);
 }
 
 void CSSParser::ParseSheetForInspector(const CSSParserContext* context,
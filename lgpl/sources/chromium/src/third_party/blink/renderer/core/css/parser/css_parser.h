@@ -15,6 +15,7 @@
 namespace blink {
 
 class Color;
+class CSSBlockSkipIndex;
 class CSSParserObserver;
 class CSSSelectorList;
 class Element;
@@ -42,7 +43,8 @@ class CORE_EXPORT CSSParser {
       const String&,
       CSSDeferPropertyParsing defer_property_parsing =
           CSSDeferPropertyParsing::kNo,
-      bool allow_import_rules = true);
+      bool allow_import_rules = true,
+      const CSSBlockSkipIndex* block_skip_index = nullptr);
   static CSSSelectorList ParseSelector(const CSSParserContext*,
                                        StyleSheetContents*,
                                        const String&);
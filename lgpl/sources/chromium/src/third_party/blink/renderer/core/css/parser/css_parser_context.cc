@@ -178,9 +178,14 @@ CSSParserContext::CSSParserContext(
       resource_fetch_restriction_(resource_fetch_restriction) {}
 
 bool CSSParserContext::operator==(const CSSParserContext& other) const {
-  return base_url_ == other.base_url_ && origin_clean_ == other.origin_clean_ &&
-         charset_ == other.charset_ && mode_ == other.mode_ &&
-         match_mode_ == other.match_mode_ && profile_ == other.profile_ &&
+  return base_url_ == other.base_url_ && EqualsIgnoringBaseURL(other);
+}
+
+bool CSSParserContext::EqualsIgnoringBaseURL(
+    const CSSParserContext& other) const {
+  return origin_clean_ == other.origin_clean_ && charset_ == other.charset_ &&
+         mode_ == other.mode_ && match_mode_ == other.match_mode_ &&
+         profile_ == other.profile_ &&
          is_html_document_ == other.is_html_document_ &&
          use_legacy_background_size_shorthand_behavior_ ==
              other.use_legacy_background_size_shorthand_behavior_ &&
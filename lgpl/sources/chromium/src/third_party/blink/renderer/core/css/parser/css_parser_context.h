@@ -81,6 +81,9 @@ class CORE_EXPORT CSSParserContext final
   bool operator!=(const CSSParserContext& other) const {
     return !(*this == other);
   }
+  // Like operator==, but allows the contexts to resolve relative URLs
+  // differently.
+  bool EqualsIgnoringBaseURL(const CSSParserContext&) const;
 
   CSSParserMode Mode() const { return mode_; }
   CSSParserMode MatchMode() const { return match_mode_; }
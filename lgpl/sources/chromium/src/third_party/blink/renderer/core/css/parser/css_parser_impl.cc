@@ -14,6 +14,7 @@
 #include "third_party/blink/renderer/core/css/css_style_sheet.h"
 #include "third_party/blink/renderer/core/css/parser/at_rule_descriptor_parser.h"
 #include "third_party/blink/renderer/core/css/parser/css_at_rule_id.h"
+#include "third_party/blink/renderer/core/css/parser/css_block_skip_index.h"
 #include "third_party/blink/renderer/core/css/parser/css_lazy_parsing_state.h"
 #include "third_party/blink/renderer/core/css/parser/css_lazy_property_parser_impl.h"
 #include "third_party/blink/renderer/core/css/parser/css_parser_observer.h"
@@ -248,7 +249,8 @@ ParseSheetResult CSSParserImpl::ParseStyleSheet(
     const CSSParserContext* context,
     StyleSheetContents* style_sheet,
     CSSDeferPropertyParsing defer_property_parsing,
-    bool allow_import_rules) {
+    bool allow_import_rules,
+    const CSSBlockSkipIndex* block_skip_index) {
   TRACE_EVENT_BEGIN2("blink,blink_style", "CSSParserImpl::parseStyleSheet",
                      "baseUrl", context->BaseURL().GetString().Utf8(), "mode",
                      context->Mode());
@@ -261,6 +263,10 @@ ParseSheetResult CSSParserImpl::ParseStyleSheet(
   if (defer_property_parsing == CSSDeferPropertyParsing::kYes) {
     parser.lazy_state_ = MakeGarbageCollected<CSSLazyParsingState>(
         context, string, parser.style_sheet_);
+    if (block_skip_index) {
+      DCHECK_EQ(block_skip_index->TextLength(), string.length());
+      parser.block_skip_index_ = block_skip_index;
+    }
   }
   ParseSheetResult result = ParseSheetResult::kSucceeded;
   bool first_rule_valid = parser.ConsumeRuleList(
@@ -888,9 +894,18 @@ StyleRule* CSSParserImpl::ConsumeStyleRule(CSSParserTokenStream& stream) {
   // TODO(csharrison): How should we lazily parse css that needs the observer?
   if (!observer_ && lazy_state_) {
     DCHECK(style_sheet_);
+    wtf_size_t block_start_offset = stream.Offset();
+    if (block_skip_index_) {
+      // The declarations are tokenized when they are parsed lazily, don't
+      // tokenize them here only to skip to the end of the block.
+      if (wtf_size_t block_end_offset =
+              block_skip_index_->FindBlockEnd(block_start_offset)) {
+        stream.SkipBlockContents(block_end_offset);
+      }
+    }
     return MakeGarbageCollected<StyleRule>(
         std::move(selector_list),
-        MakeGarbageCollected<CSSLazyPropertyParserImpl>(stream.Offset() - 1,
+        MakeGarbageCollected<CSSLazyPropertyParserImpl>(block_start_offset - 1,
                                                         lazy_state_));
   }
   ConsumeDeclarationList(stream, StyleRule::kStyle);
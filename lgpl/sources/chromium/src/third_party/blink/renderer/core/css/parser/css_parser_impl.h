@@ -19,6 +19,7 @@
 
 namespace blink {
 
+class CSSBlockSkipIndex;
 class CSSLazyParsingState;
 class CSSParserContext;
 class CSSParserObserver;
@@ -103,12 +104,15 @@ class CSSParserImpl {
                                   const CSSParserContext*,
                                   StyleSheetContents*,
                                   AllowedRulesType);
+  // |block_skip_index| must have been built from the same string, and is only
+  // used when deferring property parsing.
   static ParseSheetResult ParseStyleSheet(
       const String&,
       const CSSParserContext*,
       StyleSheetContents*,
       CSSDeferPropertyParsing = CSSDeferPropertyParsing::kNo,
-      bool allow_import_rules = true);
+      bool allow_import_rules = true,
+      const CSSBlockSkipIndex* block_skip_index = nullptr);
   static CSSSelectorList ParsePageSelector(CSSParserTokenRange,
                                            StyleSheetContents*);
 
@@ -205,6 +209,7 @@ class CSSParserImpl {
   CSSParserObserver* observer_;
 
   Member<CSSLazyParsingState> lazy_state_;
+  const CSSBlockSkipIndex* block_skip_index_ = nullptr;
   DISALLOW_COPY_AND_ASSIGN(CSSParserImpl);
 };
 
@@ -132,6 +132,15 @@ class CORE_EXPORT CSSParserTokenStream {
     return tokenizer_.PreviousOffset();
   }
 
+  // Skips the contents of the block just entered with a BlockGuard, up to the
+  // token ending it at |block_end_offset|. See CSSBlockSkipIndex.
+  void SkipBlockContents(wtf_size_t block_end_offset) {
+    DCHECK(!HasLookAhead());
+    DCHECK_GE(block_end_offset, offset_);
+    tokenizer_.SkipTo(block_end_offset);
+    offset_ = block_end_offset;
+  }
+
   void ConsumeWhitespace();
   CSSParserToken ConsumeIncludingWhitespace();
   void UncheckedConsumeComponentValue();
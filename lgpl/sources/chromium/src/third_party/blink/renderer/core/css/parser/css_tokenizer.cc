@@ -321,12 +321,12 @@ CSSParserToken CSSTokenizer::ConsumeNumber() {
     sign = kMinusSign;
   }
 
-  number_length = input_.SkipWhilePredicate<IsASCIIDigit>(number_length);
+  number_length = input_.SkipWhileASCIIDigit(number_length);
   next = input_.PeekWithoutReplacement(number_length);
   if (next == '.' &&
       IsASCIIDigit(input_.PeekWithoutReplacement(number_length + 1))) {
     type = kNumberValueType;
-    number_length = input_.SkipWhilePredicate<IsASCIIDigit>(number_length + 2);
+    number_length = input_.SkipWhileASCIIDigit(number_length + 2);
     next = input_.PeekWithoutReplacement(number_length);
   }
 
@@ -334,13 +334,11 @@ CSSParserToken CSSTokenizer::ConsumeNumber() {
     next = input_.PeekWithoutReplacement(number_length + 1);
     if (IsASCIIDigit(next)) {
       type = kNumberValueType;
-      number_length =
-          input_.SkipWhilePredicate<IsASCIIDigit>(number_length + 1);
+      number_length = input_.SkipWhileASCIIDigit(number_length + 1);
     } else if ((next == '+' || next == '-') &&
                IsASCIIDigit(input_.PeekWithoutReplacement(number_length + 2))) {
       type = kNumberValueType;
-      number_length =
-          input_.SkipWhilePredicate<IsASCIIDigit>(number_length + 3);
+      number_length = input_.SkipWhileASCIIDigit(number_length + 3);
     }
   }
 
@@ -550,17 +548,14 @@ bool CSSTokenizer::ConsumeIfNext(UChar character) {
 // http://www.w3.org/TR/css3-syntax/#consume-a-name
 StringView CSSTokenizer::ConsumeName() {
   // Names without escapes get handled without allocations
-  for (unsigned size = 0;; ++size) {
-    UChar cc = input_.PeekWithoutReplacement(size);
-    if (IsNameCodePoint(cc))
-      continue;
-    // peekWithoutReplacement will return NUL when we hit the end of the
-    // input. In that case we want to still use the rangeAt() fast path
-    // below.
-    if (cc == '\0' && input_.Offset() + size < input_.length())
-      break;
-    if (cc == '\\')
-      break;
+  unsigned size = input_.SkipWhileNameCodePoint(0);
+  UChar cc = input_.PeekWithoutReplacement(size);
+  // PeekWithoutReplacement will return NUL when we hit the end of the
+  // input. In that case we want to still use the RangeAt() fast path
+  // below.
+  bool is_end_of_name =
+      cc != '\\' && (cc != '\0' || input_.Offset() + size >= input_.length());
+  if (is_end_of_name) {
     unsigned start_offset = input_.Offset();
     input_.Advance(size);
     return input_.RangeAt(start_offset, size);
@@ -36,6 +36,13 @@ class CORE_EXPORT CSSTokenizer {
   CSSParserToken TokenizeSingle();
   CSSParserToken TokenizeSingleWithComments();
 
+  // Moves the input to |offset| without producing tokens. The skipped input
+  // must not change the block nesting, see CSSBlockSkipIndex.
+  void SkipTo(wtf_size_t offset) {
+    DCHECK_GE(offset, input_.Offset());
+    input_.Advance(offset - input_.Offset());
+  }
+
   CSSParserToken NextToken();
 
   UChar Consume();
@@ -107,6 +114,7 @@ class CORE_EXPORT CSSTokenizer {
   // We only allocate strings when escapes are used.
   Vector<String> string_pool_;
 
+  friend class CSSBlockSkipIndex;
   friend class CSSParserTokenStream;
 
   wtf_size_t prev_offset_ = 0;
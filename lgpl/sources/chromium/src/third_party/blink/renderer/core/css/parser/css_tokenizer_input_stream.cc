@@ -4,20 +4,130 @@
 
 #include "third_party/blink/renderer/core/css/parser/css_tokenizer_input_stream.h"
 
+#include "base/bits.h"
+#include "build/build_config.h"
+#include "third_party/blink/renderer/core/css/parser/css_parser_idioms.h"
 #include "third_party/blink/renderer/core/html/parser/html_parser_idioms.h"
 #include "third_party/blink/renderer/platform/wtf/text/string_to_number.h"
 
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#define CSS_TOKENIZER_USE_SSE2 1
+#endif
+
 namespace blink {
 
+namespace {
+
+enum class CharacterClass { kNameCodePoint, kWhitespace, kASCIIDigit };
+
+template <CharacterClass character_class>
+inline bool IsInClass(LChar c) {
+  switch (character_class) {
+    case CharacterClass::kNameCodePoint:
+      return IsNameCodePoint(c);
+    case CharacterClass::kWhitespace:
+      // Using HTML space here rather than CSS space since we don't do
+      // preprocessing.
+      return IsHTMLSpace<LChar>(c);
+    case CharacterClass::kASCIIDigit:
+      return IsASCIIDigit(c);
+  }
+}
+
+#if defined(CSS_TOKENIZER_USE_SSE2)
+// Bytes are compared as signed, so the ranges below never include characters
+// outside of ASCII.
+inline __m128i InRange(__m128i chars, char first, char last) {
+  return _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8(first - 1)),
+                       _mm_cmplt_epi8(chars, _mm_set1_epi8(last + 1)));
+}
+
+inline __m128i Equals(__m128i chars, char c) {
+  return _mm_cmpeq_epi8(chars, _mm_set1_epi8(c));
+}
+
+// Returns a mask with 0xFF in every byte of |chars| which is in
+// |character_class|.
+template <CharacterClass character_class>
+inline __m128i ClassMask(__m128i chars) {
+  switch (character_class) {
+    case CharacterClass::kNameCodePoint: {
+      __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+      __m128i mask = _mm_or_si128(InRange(lower, 'a', 'z'),
+                                  InRange(chars, '0', '9'));
+      mask = _mm_or_si128(mask, Equals(chars, '_'));
+      mask = _mm_or_si128(mask, Equals(chars, '-'));
+      // Non-ASCII characters are name code points.
+      return _mm_or_si128(mask, _mm_cmplt_epi8(chars, _mm_setzero_si128()));
+    }
+    case CharacterClass::kWhitespace: {
+      __m128i mask = _mm_or_si128(Equals(chars, ' '), Equals(chars, '\n'));
+      mask = _mm_or_si128(mask, Equals(chars, '\t'));
+      mask = _mm_or_si128(mask, Equals(chars, '\r'));
+      return _mm_or_si128(mask, Equals(chars, '\f'));
+    }
+    case CharacterClass::kASCIIDigit:
+      return InRange(chars, '0', '9');
+  }
+}
+#endif  // defined(CSS_TOKENIZER_USE_SSE2)
+
+// Returns the index of the first character at or after |index| which is not
+// in |character_class|, or |length| if there is none.
+template <CharacterClass character_class>
+wtf_size_t SkipWhileInClass(const LChar* characters,
+                            wtf_size_t index,
+                            wtf_size_t length) {
+#if defined(CSS_TOKENIZER_USE_SSE2)
+  constexpr wtf_size_t kStride = sizeof(__m128i);
+  while (length - index >= kStride) {
+    __m128i chars =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters + index));
+    uint32_t outside_class =
+        ~_mm_movemask_epi8(ClassMask<character_class>(chars)) & 0xFFFF;
+    if (outside_class)
+      return index + base::bits::CountTrailingZeroBits(outside_class);
+    index += kStride;
+  }
+#endif  // defined(CSS_TOKENIZER_USE_SSE2)
+  while (index < length && IsInClass<character_class>(characters[index]))
+    ++index;
+  return index;
+}
+
+}  // namespace
+
 CSSTokenizerInputStream::CSSTokenizerInputStream(const String& input)
     : offset_(0), string_length_(input.length()), string_(input.Impl()) {}
 
+unsigned CSSTokenizerInputStream::SkipWhileNameCodePoint(unsigned offset) {
+  if (!string_->Is8Bit())
+    return SkipWhilePredicate<IsNameCodePoint>(offset);
+  if (offset_ + offset >= string_length_)
+    return offset;
+  return SkipWhileInClass<CharacterClass::kNameCodePoint>(
+             string_->Characters8(), offset_ + offset, string_length_) -
+         offset_;
+}
+
+unsigned CSSTokenizerInputStream::SkipWhileASCIIDigit(unsigned offset) {
+  if (!string_->Is8Bit())
+    return SkipWhilePredicate<IsASCIIDigit>(offset);
+  if (offset_ + offset >= string_length_)
+    return offset;
+  return SkipWhileInClass<CharacterClass::kASCIIDigit>(
+             string_->Characters8(), offset_ + offset, string_length_) -
+         offset_;
+}
+
 void CSSTokenizerInputStream::AdvanceUntilNonWhitespace() {
   // Using HTML space here rather than CSS space since we don't do preprocessing
   if (string_->Is8Bit()) {
-    const LChar* characters = string_->Characters8();
-    while (offset_ < string_length_ && IsHTMLSpace(characters[offset_]))
-      ++offset_;
+    if (offset_ < string_length_) {
+      offset_ = SkipWhileInClass<CharacterClass::kWhitespace>(
+          string_->Characters8(), offset_, string_length_);
+    }
   } else {
     const UChar* characters = string_->Characters16();
     while (offset_ < string_length_ && IsHTMLSpace(characters[offset_]))
@@ -61,6 +61,12 @@ class CSSTokenizerInputStream {
     return offset;
   }
 
+  // Like SkipWhilePredicate<IsNameCodePoint> and
+  // SkipWhilePredicate<IsASCIIDigit>, but 8-bit input is scanned 16
+  // characters at a time where SIMD is available.
+  unsigned SkipWhileNameCodePoint(unsigned offset);
+  unsigned SkipWhileASCIIDigit(unsigned offset);
+
   void AdvanceUntilNonWhitespace();
 
   unsigned length() const { return string_length_; }
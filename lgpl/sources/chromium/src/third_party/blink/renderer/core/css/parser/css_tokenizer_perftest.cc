@@ -0,0 +1,55 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/css/parser/css_tokenizer.h"
+
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
+
+namespace blink {
+
+namespace {
+
+// Roughly mimics the shape of a large framework stylesheet: long class names,
+// custom properties, numbers with units and indentation.
+String BuildStyleSheet(unsigned rule_count) {
+  StringBuilder builder;
+  for (unsigned i = 0; i < rule_count; ++i) {
+    builder.Append(".framework-component__element--modifier-");
+    builder.AppendNumber(i);
+    builder.Append(
+        " > .another-rather-long-class-name:not(.is-disabled) {\n"
+        "    --framework-custom-property-name: 1234567890px;\n"
+        "    margin: 0 auto 16.5px 0;\n"
+        "    background-color: rgba(255, 255, 255, 0.875);\n"
+        "    transition: transform 150ms cubic-bezier(0.4, 0, 0.2, 1);\n"
+        "}\n\n");
+  }
+  return builder.ToString();
+}
+
+}  // namespace
+
+TEST(CSSTokenizerPerfTest, LargeStyleSheet) {
+  const unsigned kIterationCount = 20;
+  const String sheet_text = BuildStyleSheet(10000);
+  ASSERT_TRUE(sheet_text.Is8Bit());
+
+  size_t token_count = 0;
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (unsigned count = 0; count < kIterationCount; count++) {
+    CSSTokenizer tokenizer(sheet_text);
+    token_count += tokenizer.TokenizeToEOF().size();
+  }
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+  LOG(ERROR) << "  Time to tokenize " << sheet_text.length() << " bytes "
+             << kIterationCount << " times: " << elapsed.InMilliseconds()
+             << "ms";
+  LOG(ERROR) << "    Tokens per second: "
+             << static_cast<int64_t>(token_count / elapsed.InSecondsF());
+}
+
+}  // namespace blink
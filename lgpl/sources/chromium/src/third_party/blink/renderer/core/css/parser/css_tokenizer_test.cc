@@ -274,6 +274,32 @@ TEST(CSSTokenizerTest, IdentToken) {
   TEST_TOKENS(String("ab\0c", 4u), Ident("ab" + FromUChar32(0xFFFD) + "c"));
 }
 
+TEST(CSSTokenizerTest, LongRuns) {
+  // 8-bit input is scanned in blocks of 16 characters, make sure the end of
+  // a run is found at every position within a block.
+  const String name =
+      "abcdefghijklmnopqrstuvwxyz-_0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  for (unsigned length = 1; length <= name.length(); ++length) {
+    String ident = name.Left(length);
+    TEST_TOKENS(ident + "!", Ident(ident), Delim('!'));
+    TEST_TOKENS(ident + "  \t\n\r\f  \t\n\r\f  \t\n\r\f\t#",
+                Ident(ident), Whitespace(), Delim('#'));
+  }
+  String digits = "12345678901234567890";
+  TEST_TOKENS(digits + "px",
+              Dimension(kIntegerValueType, 1.2345678901234567e19, "px"));
+  TEST_TOKENS(digits + "." + digits + "em",
+              Dimension(kNumberValueType, 1.2345678901234567e19, "em"));
+  String latin1 = "caf" + FromUChar32(0xE9) + "-caf" + FromUChar32(0xE9) +
+                  "-caf" + FromUChar32(0xE9) + "-caf" + FromUChar32(0xE9);
+  ASSERT_TRUE(latin1.Is8Bit());
+  TEST_TOKENS(latin1 + ";", Ident(latin1), Semicolon());
+  TEST_TOKENS(String("abcdefghijklmnopqrstuvwxyz\0z", 28u),
+              Ident("abcdefghijklmnopqrstuvwxyz" + FromUChar32(0xFFFD) + "z"));
+  TEST_TOKENS("abcdefghijklmnopqrstuvwxyz\\6d",
+              Ident("abcdefghijklmnopqrstuvwxyzm"));
+}
+
 TEST(CSSTokenizerTest, FunctionToken) {
   TEST_TOKENS("scale(2)", Func("scale"), Number(kIntegerValueType, 2, kNoSign),
               RightParenthesis());
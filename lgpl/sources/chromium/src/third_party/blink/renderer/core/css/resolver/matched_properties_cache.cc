@@ -30,9 +30,14 @@
 
 #include "third_party/blink/renderer/core/css/resolver/matched_properties_cache.h"
 
+#include "third_party/blink/renderer/core/css/css_primitive_value.h"
 #include "third_party/blink/renderer/core/css/css_property_value_set.h"
+#include "third_party/blink/renderer/core/css/css_value_list.h"
+#include "third_party/blink/renderer/core/css/css_value_pair.h"
 #include "third_party/blink/renderer/core/css/resolver/style_resolver_state.h"
 #include "third_party/blink/renderer/core/style/computed_style.h"
+#include "third_party/blink/renderer/platform/heap/persistent.h"
+#include "third_party/blink/renderer/platform/wtf/std_lib_extras.h"
 
 namespace blink {
 
@@ -48,6 +53,21 @@ void CachedMatchedProperties::Set(const ComputedStyle& style,
   this->parent_computed_style = ComputedStyle::Clone(parent_style);
 }
 
+void CachedMatchedProperties::SetDocumentIndependent(
+    const ComputedStyle& style,
+    const MatchedPropertiesVector& properties) {
+  matched_properties.AppendVector(properties);
+
+  // Start from the initial style so that no Font (with its FontSelector) or
+  // other inherited data of the originating document is kept alive.
+  computed_style = ComputedStyle::Create();
+  computed_style->CopyNonInheritedFromCached(style);
+  computed_style->SetFontDescription(style.GetFontDescription());
+  computed_style->SetEffectiveZoom(style.EffectiveZoom());
+  computed_style->SetInsideLink(style.InsideLink());
+  parent_computed_style = nullptr;
+}
+
 void CachedMatchedProperties::Clear() {
   matched_properties.clear();
   computed_style = nullptr;
@@ -56,16 +76,17 @@ void CachedMatchedProperties::Clear() {
 
 MatchedPropertiesCache::MatchedPropertiesCache() = default;
 
-const CachedMatchedProperties* MatchedPropertiesCache::Find(
+static const CachedMatchedProperties* FindInCache(
+    const MatchedPropertiesCache::Cache& cache,
     unsigned hash,
     const StyleResolverState& style_resolver_state,
     const MatchedPropertiesVector& properties) {
   DCHECK(hash);
 
-  Cache::iterator it = cache_.find(hash);
-  if (it == cache_.end())
+  auto it = cache.find(hash);
+  if (it == cache.end())
     return nullptr;
-  CachedMatchedProperties* cache_item = it->value.Get();
+  const CachedMatchedProperties* cache_item = it->value.Get();
   if (!cache_item)
     return nullptr;
 
@@ -82,6 +103,13 @@ const CachedMatchedProperties* MatchedPropertiesCache::Find(
   return cache_item;
 }
 
+const CachedMatchedProperties* MatchedPropertiesCache::Find(
+    unsigned hash,
+    const StyleResolverState& style_resolver_state,
+    const MatchedPropertiesVector& properties) {
+  return FindInCache(cache_, hash, style_resolver_state, properties);
+}
+
 void MatchedPropertiesCache::Add(const ComputedStyle& style,
                                  const ComputedStyle& parent_style,
                                  unsigned hash,
@@ -160,4 +188,98 @@ void MatchedPropertiesCache::Trace(blink::Visitor* visitor) {
   visitor->Trace(cache_);
 }
 
+SharedMatchedPropertiesCache& SharedMatchedPropertiesCache::Instance() {
+  DCHECK(IsMainThread());
+  DEFINE_STATIC_LOCAL(Persistent<SharedMatchedPropertiesCache>, cache,
+                      (MakeGarbageCollected<SharedMatchedPropertiesCache>()));
+  return *cache;
+}
+
+const CachedMatchedProperties* SharedMatchedPropertiesCache::Find(
+    unsigned hash,
+    const StyleResolverState& style_resolver_state,
+    const MatchedPropertiesVector& properties) {
+  const CachedMatchedProperties* cache_item =
+      FindInCache(cache_, hash, style_resolver_state, properties);
+  if (cache_item)
+    lru_list_.PrependOrMoveToFirst(hash);
+  return cache_item;
+}
+
+void SharedMatchedPropertiesCache::Add(
+    const ComputedStyle& style,
+    unsigned hash,
+    const MatchedPropertiesVector& properties) {
+  DCHECK(hash);
+  DCHECK(IsSharable(style, properties));
+  if (lru_list_.PrependOrMoveToFirst(hash).is_new_entry &&
+      lru_list_.size() > kMaxEntries) {
+    cache_.erase(lru_list_.back());
+    lru_list_.pop_back();
+  }
+
+  auto* cache_item = MakeGarbageCollected<CachedMatchedProperties>();
+  cache_item->SetDocumentIndependent(style, properties);
+  cache_.Set(hash, cache_item);
+}
+
+void SharedMatchedPropertiesCache::Clear() {
+  for (auto& cache_entry : cache_) {
+    if (cache_entry.value)
+      cache_entry.value->Clear();
+  }
+  cache_.clear();
+  lru_list_.clear();
+}
+
+static bool IsDocumentIndependentValue(const CSSValue& value) {
+  if (const auto* list = DynamicTo<CSSValueList>(value)) {
+    for (const CSSValue* item : *list) {
+      if (!IsDocumentIndependentValue(*item))
+        return false;
+    }
+    return true;
+  }
+  if (const auto* pair = DynamicTo<CSSValuePair>(value)) {
+    return IsDocumentIndependentValue(pair->First()) &&
+           IsDocumentIndependentValue(pair->Second());
+  }
+  if (const auto* primitive_value = DynamicTo<CSSPrimitiveValue>(value)) {
+    // Glyph relative units resolve against the fonts of the originating
+    // document, including its web fonts.
+    CSSPrimitiveValue::LengthTypeFlags types;
+    primitive_value->AccumulateLengthUnitTypes(types);
+    return !types.test(CSSPrimitiveValue::kUnitTypeFontXSize) &&
+           !types.test(CSSPrimitiveValue::kUnitTypeZeroCharacterWidth);
+  }
+  // Any other value may hold lengths (e.g. shadows, quads and basic shapes)
+  // or resources of the originating document, so only values known to hold
+  // neither are shared.
+  return value.IsIdentifierValue() || value.IsColorValue() ||
+         value.IsStringValue() || value.IsCustomIdentValue() ||
+         value.IsCSSWideKeyword() || value.IsFontFamilyValue() ||
+         value.IsCubicBezierTimingFunctionValue() ||
+         value.IsStepsTimingFunctionValue();
+}
+
+bool SharedMatchedPropertiesCache::IsSharable(
+    const ComputedStyle& style,
+    const MatchedPropertiesVector& properties) {
+  // Viewport and rem units resolve against the originating document.
+  if (style.HasViewportUnits() || style.HasRemUnits())
+    return false;
+  for (const auto& matched_properties : properties) {
+    const CSSPropertyValueSet& property_set = *matched_properties.properties;
+    for (unsigned i = 0; i < property_set.PropertyCount(); ++i) {
+      if (!IsDocumentIndependentValue(property_set.PropertyAt(i).Value()))
+        return false;
+    }
+  }
+  return true;
+}
+
+void SharedMatchedPropertiesCache::Trace(blink::Visitor* visitor) {
+  visitor->Trace(cache_);
+}
+
 }  // namespace blink
@@ -30,6 +30,7 @@
 #include "third_party/blink/renderer/platform/heap/handle.h"
 #include "third_party/blink/renderer/platform/wtf/forward.h"
 #include "third_party/blink/renderer/platform/wtf/hash_map.h"
+#include "third_party/blink/renderer/platform/wtf/linked_hash_set.h"
 
 namespace blink {
 
@@ -46,6 +47,12 @@ class CachedMatchedProperties final
   void Set(const ComputedStyle&,
            const ComputedStyle& parent_style,
            const MatchedPropertiesVector&);
+  // Like Set(), but only keeps the parts of the style which can be reused by
+  // other documents: the non-inherited data, the FontDescription and the
+  // effective zoom. parent_computed_style is left null, so entries set this
+  // way never produce inherited cache hits.
+  void SetDocumentIndependent(const ComputedStyle&,
+                              const MatchedPropertiesVector&);
   void Clear();
   void Trace(blink::Visitor* visitor) { visitor->Trace(matched_properties); }
 };
@@ -102,6 +109,12 @@ class CORE_EXPORT MatchedPropertiesCache {
   DISALLOW_NEW();
 
  public:
+  using Cache = HeapHashMap<unsigned,
+                            Member<CachedMatchedProperties>,
+                            DefaultHash<unsigned>::Hash,
+                            HashTraits<unsigned>,
+                            CachedMatchedPropertiesHashTraits>;
+
   MatchedPropertiesCache();
   ~MatchedPropertiesCache() { DCHECK(cache_.IsEmpty()); }
 
@@ -122,15 +135,46 @@ class CORE_EXPORT MatchedPropertiesCache {
   void Trace(blink::Visitor*);
 
  private:
-  using Cache = HeapHashMap<unsigned,
-                            Member<CachedMatchedProperties>,
-                            DefaultHash<unsigned>::Hash,
-                            HashTraits<unsigned>,
-                            CachedMatchedPropertiesHashTraits>;
   Cache cache_;
   DISALLOW_COPY_AND_ASSIGN(MatchedPropertiesCache);
 };
 
+// Second level MatchedPropertiesCache shared by all the documents on the main
+// thread. The matched properties hash includes the identity of the
+// CSSPropertyValueSets, so entries are only found for documents which share
+// StyleSheetContents, e.g. the UA sheets and site sheets restored from the
+// memory cache. Only matched properties which do not reference
+// document-bound resources like images and urls are added, and only the
+// non-inherited part of the cached style is reused.
+class CORE_EXPORT SharedMatchedPropertiesCache final
+    : public GarbageCollected<SharedMatchedPropertiesCache> {
+ public:
+  static SharedMatchedPropertiesCache& Instance();
+
+  SharedMatchedPropertiesCache() = default;
+
+  const CachedMatchedProperties* Find(unsigned hash,
+                                      const StyleResolverState&,
+                                      const MatchedPropertiesVector&);
+  void Add(const ComputedStyle&, unsigned hash, const MatchedPropertiesVector&);
+  void Clear();
+
+  wtf_size_t size() const { return cache_.size(); }
+
+  static bool IsSharable(const ComputedStyle&, const MatchedPropertiesVector&);
+
+  // The least recently used entry is evicted when adding to a full cache.
+  static constexpr wtf_size_t kMaxEntries = 2048;
+
+  void Trace(blink::Visitor*);
+
+ private:
+  MatchedPropertiesCache::Cache cache_;
+  // The hashes of |cache_|, most recently found or added first.
+  LinkedHashSet<unsigned> lru_list_;
+  DISALLOW_COPY_AND_ASSIGN(SharedMatchedPropertiesCache);
+};
+
 }  // namespace blink
 
 #endif
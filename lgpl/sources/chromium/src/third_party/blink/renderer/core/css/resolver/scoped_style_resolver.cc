@@ -83,9 +83,27 @@ void ScopedStyleResolver::AddFontFaceRules(const RuleSet& rule_set) {
     document.GetStyleResolver()->InvalidateMatchedPropertiesCache();
 }
 
+// static
+void ScopedStyleResolver::CollectSubSetFeaturesTo(
+    RuleFeatureSet& features,
+    const CSSStyleSheetRuleSubSet* sub_sets,
+    wtf_size_t start_index) {
+  if (!sub_sets)
+    return;
+  for (wtf_size_t i = start_index; i < sub_sets->size(); ++i)
+    features.Add(sub_sets->at(i)->rule_set_->Features());
+}
+
 void ScopedStyleResolver::AppendActiveStyleSheets(
     unsigned index,
-    const ActiveStyleSheetVector& active_sheets) {
+    const ActiveStyleSheetVector& active_sheets,
+    RuleFeatureSet* appended_features) {
+  wtf_size_t tree_boundary_crossing_start =
+      tree_boundary_crossing_rule_set_
+          ? tree_boundary_crossing_rule_set_->size()
+          : 0;
+  wtf_size_t slotted_start = slotted_rule_set_ ? slotted_rule_set_->size() : 0;
+
   for (auto* active_iterator = active_sheets.begin() + index;
        active_iterator != active_sheets.end(); active_iterator++) {
     CSSStyleSheet* sheet = active_iterator->first;
@@ -93,6 +111,12 @@ void ScopedStyleResolver::AppendActiveStyleSheets(
         sheet->ViewportDependentMediaQueryResults());
     device_dependent_media_query_results_.AppendVector(
         sheet->DeviceDependentMediaQueryResults());
+    if (appended_features) {
+      appended_features->ViewportDependentMediaQueryResults().AppendVector(
+          sheet->ViewportDependentMediaQueryResults());
+      appended_features->DeviceDependentMediaQueryResults().AppendVector(
+          sheet->DeviceDependentMediaQueryResults());
+    }
     if (!active_iterator->second)
       continue;
     const RuleSet& rule_set = *active_iterator->second;
@@ -101,6 +125,16 @@ void ScopedStyleResolver::AppendActiveStyleSheets(
     AddFontFaceRules(rule_set);
     AddTreeBoundaryCrossingRules(rule_set, sheet, index);
     AddSlottedRules(rule_set, sheet, index++);
+    if (appended_features)
+      appended_features->Add(rule_set.Features());
+  }
+
+  if (appended_features) {
+    CollectSubSetFeaturesTo(*appended_features,
+                            tree_boundary_crossing_rule_set_,
+                            tree_boundary_crossing_start);
+    CollectSubSetFeaturesTo(*appended_features, slotted_rule_set_,
+                            slotted_start);
   }
 }
 
@@ -58,7 +58,11 @@ class CORE_EXPORT ScopedStyleResolver final
   StyleRuleKeyframes* KeyframeStylesForAnimation(
       const StringImpl* animation_name);
 
-  void AppendActiveStyleSheets(unsigned index, const ActiveStyleSheetVector&);
+  // If |appended_features| is given, the features of the appended sheets are
+  // collected into it, like CollectFeaturesTo() does for all sheets.
+  void AppendActiveStyleSheets(unsigned index,
+                               const ActiveStyleSheetVector&,
+                               RuleFeatureSet* appended_features = nullptr);
   void CollectMatchingAuthorRules(ElementRuleCollector&,
                                   ShadowV0CascadeOrder = kIgnoreCascadeOrder);
   void CollectMatchingShadowHostRules(
@@ -122,6 +126,11 @@ class CORE_EXPORT ScopedStyleResolver final
   };
   using CSSStyleSheetRuleSubSet = HeapVector<Member<RuleSubSet>>;
 
+  // Collects features from the sub sets at |start_index| and after.
+  static void CollectSubSetFeaturesTo(RuleFeatureSet&,
+                                      const CSSStyleSheetRuleSubSet*,
+                                      wtf_size_t start_index);
+
   Member<CSSStyleSheetRuleSubSet> tree_boundary_crossing_rule_set_;
   Member<CSSStyleSheetRuleSubSet> slotted_rule_set_;
 
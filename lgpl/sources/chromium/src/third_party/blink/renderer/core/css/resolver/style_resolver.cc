@@ -1774,6 +1774,25 @@ StyleResolver::CacheSuccess StyleResolver::ApplyMatchedCache(
                        cache_hash, state, match_result.GetMatchedProperties())
                  : nullptr;
 
+  if (!cached_matched_properties && cache_hash &&
+      RuntimeEnabledFeatures::SharedMatchedPropertiesCacheEnabled() &&
+      !IsForcedColorsModeEnabled() &&
+      MatchedPropertiesCache::IsCacheable(state)) {
+    // Entries in the shared cache only carry non-inherited data, so the
+    // inherited properties are always applied.
+    if (const CachedMatchedProperties* shared_matched_properties =
+            SharedMatchedPropertiesCache::Instance().Find(
+                cache_hash, state, match_result.GetMatchedProperties())) {
+      INCREMENT_STYLE_STATS_COUNTER(GetDocument().GetStyleEngine(),
+                                    matched_property_shared_cache_hit, 1);
+      state.Style()->CopyNonInheritedFromCached(
+          *shared_matched_properties->computed_style);
+      UpdateFont(state);
+      return CacheSuccess(false, true, true, cache_hash,
+                          shared_matched_properties);
+    }
+  }
+
   if (cached_matched_properties && MatchedPropertiesCache::IsCacheable(state)) {
     INCREMENT_STYLE_STATS_COUNTER(GetDocument().GetStyleEngine(),
                                   matched_property_cache_hit, 1);
@@ -1811,7 +1830,7 @@ StyleResolver::CacheSuccess StyleResolver::ApplyMatchedCache(
   }
 
   return CacheSuccess(is_inherited_cache_hit, is_non_inherited_cache_hit,
-                      cache_hash, cached_matched_properties);
+                      false, cache_hash, cached_matched_properties);
 }
 
 void StyleResolver::ApplyCustomProperties(StyleResolverState& state,
@@ -1987,14 +2006,27 @@ void StyleResolver::ApplyMatchedLowPriorityProperties(
 
   LoadPendingResources(state);
 
-  if (!state.IsAnimatingCustomProperties() &&
-      !cache_success.cached_matched_properties && cache_success.cache_hash &&
+  if (!state.IsAnimatingCustomProperties() && cache_success.cache_hash &&
       MatchedPropertiesCache::IsCacheable(state)) {
-    INCREMENT_STYLE_STATS_COUNTER(GetDocument().GetStyleEngine(),
-                                  matched_property_cache_added, 1);
-    matched_properties_cache_.Add(*state.Style(), *state.ParentStyle(),
-                                  cache_success.cache_hash,
-                                  match_result.GetMatchedProperties());
+    if (!cache_success.cached_matched_properties ||
+        cache_success.is_shared_cache_hit) {
+      INCREMENT_STYLE_STATS_COUNTER(GetDocument().GetStyleEngine(),
+                                    matched_property_cache_added, 1);
+      matched_properties_cache_.Add(*state.Style(), *state.ParentStyle(),
+                                    cache_success.cache_hash,
+                                    match_result.GetMatchedProperties());
+    }
+    if (!cache_success.cached_matched_properties &&
+        RuntimeEnabledFeatures::SharedMatchedPropertiesCacheEnabled() &&
+        !IsForcedColorsModeEnabled() &&
+        SharedMatchedPropertiesCache::IsSharable(
+            *state.Style(), match_result.GetMatchedProperties())) {
+      INCREMENT_STYLE_STATS_COUNTER(GetDocument().GetStyleEngine(),
+                                    matched_property_shared_cache_added, 1);
+      SharedMatchedPropertiesCache::Instance().Add(
+          *state.Style(), cache_success.cache_hash,
+          match_result.GetMatchedProperties());
+    }
   }
 
   DCHECK(!state.GetFontBuilder().FontDirty());
@@ -170,15 +170,20 @@ class CORE_EXPORT StyleResolver final : public GarbageCollected<StyleResolver> {
    public:
     bool is_inherited_cache_hit;
     bool is_non_inherited_cache_hit;
+    // True if cached_matched_properties came from the
+    // SharedMatchedPropertiesCache.
+    bool is_shared_cache_hit;
     unsigned cache_hash;
     Member<const CachedMatchedProperties> cached_matched_properties;
 
     CacheSuccess(bool is_inherited_cache_hit,
                  bool is_non_inherited_cache_hit,
+                 bool is_shared_cache_hit,
                  unsigned cache_hash,
                  const CachedMatchedProperties* cached_matched_properties)
         : is_inherited_cache_hit(is_inherited_cache_hit),
           is_non_inherited_cache_hit(is_non_inherited_cache_hit),
+          is_shared_cache_hit(is_shared_cache_hit),
           cache_hash(cache_hash),
           cached_matched_properties(cached_matched_properties) {}
 
@@ -39,6 +39,8 @@ void StyleResolverStats::Reset() {
   matched_property_cache_hit = 0;
   matched_property_cache_inherited_hit = 0;
   matched_property_cache_added = 0;
+  matched_property_shared_cache_hit = 0;
+  matched_property_shared_cache_added = 0;
   rules_fast_rejected = 0;
   rules_rejected = 0;
   rules_matched = 0;
@@ -50,6 +52,11 @@ void StyleResolverStats::Reset() {
   base_styles_used = 0;
   independent_inherited_styles_propagated = 0;
   custom_properties_applied = 0;
+  recalc_subtrees = 0;
+  independent_recalc_subtrees = 0;
+  selector_filter_widened = 0;
+  selector_filter_peak_identifiers = 0;
+  selector_filter_false_positive_rate = 0;
 }
 
 std::unique_ptr<TracedValue> StyleResolverStats::ToTracedValue() const {
@@ -61,6 +68,10 @@ std::unique_ptr<TracedValue> StyleResolverStats::ToTracedValue() const {
                            matched_property_cache_inherited_hit);
   traced_value->SetInteger("matchedPropertyCacheAdded",
                            matched_property_cache_added);
+  traced_value->SetInteger("matchedPropertySharedCacheHit",
+                           matched_property_shared_cache_hit);
+  traced_value->SetInteger("matchedPropertySharedCacheAdded",
+                           matched_property_shared_cache_added);
   traced_value->SetInteger("rulesRejected", rules_rejected);
   traced_value->SetInteger("rulesFastRejected", rules_fast_rejected);
   traced_value->SetInteger("rulesMatched", rules_matched);
@@ -74,6 +85,14 @@ std::unique_ptr<TracedValue> StyleResolverStats::ToTracedValue() const {
                            independent_inherited_styles_propagated);
   traced_value->SetInteger("customPropertiesApplied",
                            custom_properties_applied);
+  traced_value->SetInteger("recalcSubtrees", recalc_subtrees);
+  traced_value->SetInteger("independentRecalcSubtrees",
+                           independent_recalc_subtrees);
+  traced_value->SetInteger("selectorFilterWidened", selector_filter_widened);
+  traced_value->SetInteger("selectorFilterPeakIdentifiers",
+                           selector_filter_peak_identifiers);
+  traced_value->SetDouble("selectorFilterFalsePositiveRate",
+                          selector_filter_false_positive_rate);
   return traced_value;
 }
 
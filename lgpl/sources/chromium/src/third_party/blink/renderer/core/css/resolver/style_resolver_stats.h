@@ -52,6 +52,8 @@ class StyleResolverStats {
   unsigned matched_property_cache_hit;
   unsigned matched_property_cache_inherited_hit;
   unsigned matched_property_cache_added;
+  unsigned matched_property_shared_cache_hit;
+  unsigned matched_property_shared_cache_added;
   unsigned rules_fast_rejected;
   unsigned rules_rejected;
   unsigned rules_matched;
@@ -63,6 +65,13 @@ class StyleResolverStats {
   unsigned base_styles_used;
   unsigned independent_inherited_styles_propagated;
   unsigned custom_properties_applied;
+  unsigned recalc_subtrees;
+  unsigned independent_recalc_subtrees;
+  unsigned selector_filter_widened;
+  unsigned selector_filter_peak_identifiers;
+  // Estimated from the peak number of ancestor identifiers and the size of
+  // the filter in use at that point.
+  double selector_filter_false_positive_rate;
 };
 
 #define INCREMENT_STYLE_STATS_COUNTER(styleEngine, counter, n) \
@@ -6,11 +6,15 @@
 
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/renderer/core/animation/element_animations.h"
+#include "third_party/blink/renderer/core/css/resolver/matched_properties_cache.h"
+#include "third_party/blink/renderer/core/css/resolver/style_resolver_stats.h"
 #include "third_party/blink/renderer/core/css/style_engine.h"
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/dom/node_computed_style.h"
 #include "third_party/blink/renderer/core/dom/text.h"
+#include "third_party/blink/renderer/core/testing/dummy_page_holder.h"
 #include "third_party/blink/renderer/core/testing/page_test_base.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
 
 namespace blink {
 
@@ -75,4 +79,94 @@ TEST_F(StyleResolverTest, AnimationBaseComputedStyle) {
   EXPECT_EQ(20, resolver->StyleForElement(div)->FontSize());
 }
 
+TEST_F(StyleResolverTest, SharedMatchedPropertiesCacheAcrossDocuments) {
+  ScopedSharedMatchedPropertiesCacheForTest scoped_feature(true);
+  SharedMatchedPropertiesCache& shared_cache =
+      SharedMatchedPropertiesCache::Instance();
+  shared_cache.Clear();
+
+  GetDocument().body()->SetInnerHTMLFromString("<div></div>");
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_GT(shared_cache.size(), 0u);
+
+  auto other_page_holder =
+      std::make_unique<DummyPageHolder>(IntSize(800, 600));
+  Document& other_document = other_page_holder->GetDocument();
+  other_document.body()->SetInnerHTMLFromString("<div></div>");
+  other_document.View()->UpdateAllLifecyclePhases(
+      DocumentLifecycle::LifecycleUpdateReason::kTest);
+
+  StyleEngine& other_engine = other_document.GetStyleEngine();
+  StyleResolver* other_resolver = other_engine.Resolver();
+  ASSERT_TRUE(other_resolver);
+  // Make sure the lookup misses in the per-document cache.
+  other_resolver->InvalidateMatchedPropertiesCache();
+  other_engine.SetStatsEnabled(true);
+
+  // The <div> only matches UA rules, which are shared between documents.
+  Element* div = other_document.QuerySelector("div");
+  ASSERT_TRUE(div);
+  scoped_refptr<ComputedStyle> style = other_resolver->StyleForElement(div);
+  ASSERT_TRUE(style);
+  EXPECT_EQ(EDisplay::kBlock, style->Display());
+  EXPECT_EQ(1u, other_engine.Stats()->matched_property_shared_cache_hit);
+  EXPECT_EQ(0u, other_engine.Stats()->matched_property_shared_cache_added);
+
+  shared_cache.Clear();
+}
+
+TEST_F(StyleResolverTest, SharedMatchedPropertiesCacheSkipsGlyphUnits) {
+  ScopedSharedMatchedPropertiesCacheForTest scoped_feature(true);
+  SharedMatchedPropertiesCache& shared_cache =
+      SharedMatchedPropertiesCache::Instance();
+
+  GetDocument().body()->SetInnerHTMLFromString(
+      "<div id=ch style='width: 10ch'></div>"
+      "<div id=ex style='width: 10ex'></div>"
+      "<div id=px style='width: 10px'></div>");
+  UpdateAllLifecyclePhasesForTest();
+
+  StyleEngine& engine = GetDocument().GetStyleEngine();
+  StyleResolver* resolver = engine.Resolver();
+  ASSERT_TRUE(resolver);
+  resolver->InvalidateMatchedPropertiesCache();
+  shared_cache.Clear();
+  engine.SetStatsEnabled(true);
+
+  // Glyph relative units depend on the fonts of this document.
+  resolver->StyleForElement(GetDocument().getElementById("ch"));
+  resolver->StyleForElement(GetDocument().getElementById("ex"));
+  EXPECT_EQ(0u, engine.Stats()->matched_property_shared_cache_added);
+
+  resolver->StyleForElement(GetDocument().getElementById("px"));
+  EXPECT_EQ(1u, engine.Stats()->matched_property_shared_cache_added);
+
+  shared_cache.Clear();
+}
+
+TEST_F(StyleResolverTest, SharedMatchedPropertiesCacheSkipsGlyphUnitsInShadow) {
+  ScopedSharedMatchedPropertiesCacheForTest scoped_feature(true);
+  SharedMatchedPropertiesCache& shared_cache =
+      SharedMatchedPropertiesCache::Instance();
+
+  GetDocument().body()->SetInnerHTMLFromString(
+      "<div id=ex style='text-shadow: 0 0 1ex'></div>"
+      "<div id=px style='text-shadow: 0 0 1px'></div>");
+  UpdateAllLifecyclePhasesForTest();
+
+  StyleEngine& engine = GetDocument().GetStyleEngine();
+  StyleResolver* resolver = engine.Resolver();
+  ASSERT_TRUE(resolver);
+  resolver->InvalidateMatchedPropertiesCache();
+  shared_cache.Clear();
+  engine.SetStatsEnabled(true);
+
+  // Shadows are not shared at all, whatever their units.
+  resolver->StyleForElement(GetDocument().getElementById("ex"));
+  resolver->StyleForElement(GetDocument().getElementById("px"));
+  EXPECT_EQ(0u, engine.Stats()->matched_property_shared_cache_added);
+
+  shared_cache.Clear();
+}
+
 }  // namespace blink
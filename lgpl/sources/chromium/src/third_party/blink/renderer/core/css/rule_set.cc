@@ -60,19 +60,18 @@ static inline ValidPropertyFilter DetermineValidPropertyFilter(
   return ValidPropertyFilter::kNoFilter;
 }
 
-RuleData* RuleData::MaybeCreate(StyleRule* rule,
-                                unsigned selector_index,
-                                unsigned position,
-                                AddRuleFlags add_rule_flags) {
+base::Optional<RuleData> RuleData::MaybeCreate(StyleRule* rule,
+                                               unsigned selector_index,
+                                               unsigned position,
+                                               AddRuleFlags add_rule_flags) {
   // The selector index field in RuleData is only 13 bits so we can't support
   // selectors at index 8192 or beyond.
   // See https://crbug.com/804179
   if (selector_index >= (1 << RuleData::kSelectorIndexBits))
-    return nullptr;
+    return base::nullopt;
   if (position >= (1 << RuleData::kPositionBits))
-    return nullptr;
-  return MakeGarbageCollected<RuleData>(rule, selector_index, position,
-                                        add_rule_flags);
+    return base::nullopt;
+  return RuleData(rule, selector_index, position, add_rule_flags);
 }
 
 RuleData::RuleData(StyleRule* rule,
@@ -97,11 +96,11 @@ RuleData::RuleData(StyleRule* rule,
 
 void RuleSet::AddToRuleSet(const AtomicString& key,
                            PendingRuleMap& map,
-                           const RuleData* rule_data) {
-  Member<HeapLinkedStack<Member<const RuleData>>>& rules =
+                           const RuleData& rule_data) {
+  Member<HeapLinkedStack<RuleData>>& rules =
       map.insert(key, nullptr).stored_value->value;
   if (!rules)
-    rules = MakeGarbageCollected<HeapLinkedStack<Member<const RuleData>>>();
+    rules = MakeGarbageCollected<HeapLinkedStack<RuleData>>();
   rules->Push(rule_data);
 }
 
@@ -155,7 +154,7 @@ static void ExtractSelectorValues(const CSSSelector* selector,
 }
 
 bool RuleSet::FindBestRuleSetAndAdd(const CSSSelector& component,
-                                    RuleData* rule_data) {
+                                    const RuleData& rule_data) {
   AtomicString id;
   AtomicString class_name;
   AtomicString custom_pseudo_element_name;
@@ -247,21 +246,21 @@ bool RuleSet::FindBestRuleSetAndAdd(const CSSSelector& component,
 void RuleSet::AddRule(StyleRule* rule,
                       unsigned selector_index,
                       AddRuleFlags add_rule_flags) {
-  RuleData* rule_data =
+  base::Optional<RuleData> rule_data =
       RuleData::MaybeCreate(rule, selector_index, rule_count_, add_rule_flags);
   if (!rule_data) {
     // This can happen if selector_index or position is out of range.
     return;
   }
   ++rule_count_;
-  if (features_.CollectFeaturesFromRuleData(rule_data) ==
+  if (features_.CollectFeaturesFromRuleData(&*rule_data) ==
       RuleFeatureSet::kSelectorNeverMatches)
     return;
 
-  if (!FindBestRuleSetAndAdd(rule_data->Selector(), rule_data)) {
+  if (!FindBestRuleSetAndAdd(rule_data->Selector(), *rule_data)) {
     // If we didn't find a specialized map to stick it in, file under universal
     // rules.
-    universal_rules_.push_back(rule_data);
+    universal_rules_.push_back(*rule_data);
   }
 }
 
@@ -364,12 +363,11 @@ void RuleSet::AddStyleRule(StyleRule* rule, AddRuleFlags add_rule_flags) {
 void RuleSet::CompactPendingRules(PendingRuleMap& pending_map,
                                   CompactRuleMap& compact_map) {
   for (auto& item : pending_map) {
-    HeapLinkedStack<Member<const RuleData>>* pending_rules =
-        item.value.Release();
-    Member<HeapVector<Member<const RuleData>>>& rules =
+    HeapLinkedStack<RuleData>* pending_rules = item.value.Release();
+    Member<HeapVector<RuleData>>& rules =
         compact_map.insert(item.key, nullptr).stored_value->value;
     if (!rules) {
-      rules = MakeGarbageCollected<HeapVector<Member<const RuleData>>>();
+      rules = MakeGarbageCollected<HeapVector<RuleData>>();
       rules->ReserveInitialCapacity(pending_rules->size());
     } else {
       rules->ReserveCapacity(pending_rules->size());
@@ -448,7 +446,7 @@ void RuleSet::Trace(blink::Visitor* visitor) {
 #ifndef NDEBUG
 void RuleSet::Show() const {
   for (const auto& rule : all_rules_)
-    rule->Selector().Show();
+    rule.Selector().Show();
 }
 #endif
 
@@ -24,6 +24,7 @@
 #define THIRD_PARTY_BLINK_RENDERER_CORE_CSS_RULE_SET_H_
 
 #include "base/macros.h"
+#include "base/optional.h"
 #include "third_party/blink/renderer/core/core_export.h"
 #include "third_party/blink/renderer/core/css/css_keyframes_rule.h"
 #include "third_party/blink/renderer/core/css/media_query_evaluator.h"
@@ -84,12 +85,21 @@ namespace blink {
 // selectors from a single rule match the same element we can see that as one
 // match for the rule. It computes some information about the wrapped selector
 // and makes it accessible cheaply.
-class CORE_EXPORT RuleData : public GarbageCollected<RuleData> {
+//
+// RuleData objects are stored by value in the RuleSet buckets, so that
+// ElementRuleCollector can walk the specificity and identifier hashes of
+// candidate rules in contiguous memory, and only dereferences the StyleRule
+// for rules which survive the fast reject.
+class CORE_EXPORT RuleData {
+  DISALLOW_NEW();
+
  public:
-  static RuleData* MaybeCreate(StyleRule*,
-                               unsigned selector_index,
-                               unsigned position,
-                               AddRuleFlags);
+  // Returns base::nullopt if selector_index or position does not fit in the
+  // bitfields below.
+  static base::Optional<RuleData> MaybeCreate(StyleRule*,
+                                              unsigned selector_index,
+                                              unsigned position,
+                                              AddRuleFlags);
 
   RuleData(StyleRule*,
            unsigned selector_index,
@@ -187,52 +197,49 @@ class CORE_EXPORT RuleSet final : public GarbageCollected<RuleSet> {
 
   const RuleFeatureSet& Features() const { return features_; }
 
-  const HeapVector<Member<const RuleData>>* IdRules(
-      const AtomicString& key) const {
+  const HeapVector<RuleData>* IdRules(const AtomicString& key) const {
     DCHECK(!pending_rules_);
     return id_rules_.at(key);
   }
-  const HeapVector<Member<const RuleData>>* ClassRules(
-      const AtomicString& key) const {
+  const HeapVector<RuleData>* ClassRules(const AtomicString& key) const {
     DCHECK(!pending_rules_);
     return class_rules_.at(key);
   }
-  const HeapVector<Member<const RuleData>>* TagRules(
-      const AtomicString& key) const {
+  const HeapVector<RuleData>* TagRules(const AtomicString& key) const {
     DCHECK(!pending_rules_);
     return tag_rules_.at(key);
   }
-  const HeapVector<Member<const RuleData>>* ShadowPseudoElementRules(
+  const HeapVector<RuleData>* ShadowPseudoElementRules(
       const AtomicString& key) const {
     DCHECK(!pending_rules_);
     return shadow_pseudo_element_rules_.at(key);
   }
-  const HeapVector<Member<const RuleData>>* LinkPseudoClassRules() const {
+  const HeapVector<RuleData>* LinkPseudoClassRules() const {
     DCHECK(!pending_rules_);
     return &link_pseudo_class_rules_;
   }
-  const HeapVector<Member<const RuleData>>* CuePseudoRules() const {
+  const HeapVector<RuleData>* CuePseudoRules() const {
     DCHECK(!pending_rules_);
     return &cue_pseudo_rules_;
   }
-  const HeapVector<Member<const RuleData>>* FocusPseudoClassRules() const {
+  const HeapVector<RuleData>* FocusPseudoClassRules() const {
     DCHECK(!pending_rules_);
     return &focus_pseudo_class_rules_;
   }
-  const HeapVector<Member<const RuleData>>*
-  SpatialNavigationInterestPseudoClassRules() const {
+  const HeapVector<RuleData>* SpatialNavigationInterestPseudoClassRules()
+      const {
     DCHECK(!pending_rules_);
     return &spatial_navigation_interest_class_rules_;
   }
-  const HeapVector<Member<const RuleData>>* UniversalRules() const {
+  const HeapVector<RuleData>* UniversalRules() const {
     DCHECK(!pending_rules_);
     return &universal_rules_;
   }
-  const HeapVector<Member<const RuleData>>* ShadowHostRules() const {
+  const HeapVector<RuleData>* ShadowHostRules() const {
     DCHECK(!pending_rules_);
     return &shadow_host_rules_;
   }
-  const HeapVector<Member<const RuleData>>* PartPseudoRules() const {
+  const HeapVector<RuleData>* PartPseudoRules() const {
     DCHECK(!pending_rules_);
     return &part_pseudo_rules_;
   }
@@ -289,12 +296,11 @@ class CORE_EXPORT RuleSet final : public GarbageCollected<RuleSet> {
 
  private:
   using PendingRuleMap =
-      HeapHashMap<AtomicString,
-                  Member<HeapLinkedStack<Member<const RuleData>>>>;
+      HeapHashMap<AtomicString, Member<HeapLinkedStack<RuleData>>>;
   using CompactRuleMap =
-      HeapHashMap<AtomicString, Member<HeapVector<Member<const RuleData>>>>;
+      HeapHashMap<AtomicString, Member<HeapVector<RuleData>>>;
 
-  void AddToRuleSet(const AtomicString& key, PendingRuleMap&, const RuleData*);
+  void AddToRuleSet(const AtomicString& key, PendingRuleMap&, const RuleData&);
   void AddPageRule(StyleRulePage*);
   void AddViewportRule(StyleRuleViewport*);
   void AddFontFaceRule(StyleRuleFontFace*);
@@ -304,7 +310,7 @@ class CORE_EXPORT RuleSet final : public GarbageCollected<RuleSet> {
   void AddChildRules(const HeapVector<Member<StyleRuleBase>>&,
                      const MediaQueryEvaluator& medium,
                      AddRuleFlags);
-  bool FindBestRuleSetAndAdd(const CSSSelector&, RuleData*);
+  bool FindBestRuleSetAndAdd(const CSSSelector&, const RuleData&);
 
   void CompactRules();
   static void CompactPendingRules(PendingRuleMap&, CompactRuleMap&);
@@ -331,13 +337,13 @@ class CORE_EXPORT RuleSet final : public GarbageCollected<RuleSet> {
   CompactRuleMap class_rules_;
   CompactRuleMap tag_rules_;
   CompactRuleMap shadow_pseudo_element_rules_;
-  HeapVector<Member<const RuleData>> link_pseudo_class_rules_;
-  HeapVector<Member<const RuleData>> cue_pseudo_rules_;
-  HeapVector<Member<const RuleData>> focus_pseudo_class_rules_;
-  HeapVector<Member<const RuleData>> spatial_navigation_interest_class_rules_;
-  HeapVector<Member<const RuleData>> universal_rules_;
-  HeapVector<Member<const RuleData>> shadow_host_rules_;
-  HeapVector<Member<const RuleData>> part_pseudo_rules_;
+  HeapVector<RuleData> link_pseudo_class_rules_;
+  HeapVector<RuleData> cue_pseudo_rules_;
+  HeapVector<RuleData> focus_pseudo_class_rules_;
+  HeapVector<RuleData> spatial_navigation_interest_class_rules_;
+  HeapVector<RuleData> universal_rules_;
+  HeapVector<RuleData> shadow_host_rules_;
+  HeapVector<RuleData> part_pseudo_rules_;
   RuleFeatureSet features_;
   HeapVector<Member<StyleRulePage>> page_rules_;
   HeapVector<Member<StyleRuleFontFace>> font_face_rules_;
@@ -351,7 +357,7 @@ class CORE_EXPORT RuleSet final : public GarbageCollected<RuleSet> {
   Member<PendingRuleMaps> pending_rules_;
 
 #ifndef NDEBUG
-  HeapVector<Member<const RuleData>> all_rules_;
+  HeapVector<RuleData> all_rules_;
 #endif
   DISALLOW_COPY_AND_ASSIGN(RuleSet);
 };
@@ -43,9 +43,9 @@ StyleRule* CreateDummyStyleRule() {
   TestStyleSheet sheet;
   sheet.AddCSSRules("#id { color: tomato; }");
   const RuleSet& rule_set = sheet.GetRuleSet();
-  const HeapVector<Member<const RuleData>>* rules = rule_set.IdRules("id");
+  const HeapVector<RuleData>* rules = rule_set.IdRules("id");
   DCHECK_EQ(1u, rules->size());
-  return rules->at(0)->Rule();
+  return rules->at(0).Rule();
 }
 
 }  // namespace
@@ -56,10 +56,9 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_CustomPseudoElements) {
   sheet.AddCSSRules("summary::-webkit-details-marker { }");
   RuleSet& rule_set = sheet.GetRuleSet();
   AtomicString str("-webkit-details-marker");
-  const HeapVector<Member<const RuleData>>* rules =
-      rule_set.ShadowPseudoElementRules(str);
+  const HeapVector<RuleData>* rules = rule_set.ShadowPseudoElementRules(str);
   ASSERT_EQ(1u, rules->size());
-  ASSERT_EQ(str, rules->at(0)->Selector().Value());
+  ASSERT_EQ(str, rules->at(0).Selector().Value());
 }
 
 TEST(RuleSetTest, findBestRuleSetAndAdd_Id) {
@@ -68,9 +67,9 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_Id) {
   sheet.AddCSSRules("#id { }");
   RuleSet& rule_set = sheet.GetRuleSet();
   AtomicString str("id");
-  const HeapVector<Member<const RuleData>>* rules = rule_set.IdRules(str);
+  const HeapVector<RuleData>* rules = rule_set.IdRules(str);
   ASSERT_EQ(1u, rules->size());
-  ASSERT_EQ(str, rules->at(0)->Selector().Value());
+  ASSERT_EQ(str, rules->at(0).Selector().Value());
 }
 
 TEST(RuleSetTest, findBestRuleSetAndAdd_NthChild) {
@@ -79,9 +78,9 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_NthChild) {
   sheet.AddCSSRules("div:nth-child(2) { }");
   RuleSet& rule_set = sheet.GetRuleSet();
   AtomicString str("div");
-  const HeapVector<Member<const RuleData>>* rules = rule_set.TagRules(str);
+  const HeapVector<RuleData>* rules = rule_set.TagRules(str);
   ASSERT_EQ(1u, rules->size());
-  ASSERT_EQ(str, rules->at(0)->Selector().TagQName().LocalName());
+  ASSERT_EQ(str, rules->at(0).Selector().TagQName().LocalName());
 }
 
 TEST(RuleSetTest, findBestRuleSetAndAdd_ClassThenId) {
@@ -91,10 +90,10 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_ClassThenId) {
   RuleSet& rule_set = sheet.GetRuleSet();
   AtomicString str("id");
   // id is prefered over class even if class preceeds it in the selector.
-  const HeapVector<Member<const RuleData>>* rules = rule_set.IdRules(str);
+  const HeapVector<RuleData>* rules = rule_set.IdRules(str);
   ASSERT_EQ(1u, rules->size());
   AtomicString class_str("class");
-  ASSERT_EQ(class_str, rules->at(0)->Selector().Value());
+  ASSERT_EQ(class_str, rules->at(0).Selector().Value());
 }
 
 TEST(RuleSetTest, findBestRuleSetAndAdd_IdThenClass) {
@@ -103,9 +102,9 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_IdThenClass) {
   sheet.AddCSSRules("#id.class { }");
   RuleSet& rule_set = sheet.GetRuleSet();
   AtomicString str("id");
-  const HeapVector<Member<const RuleData>>* rules = rule_set.IdRules(str);
+  const HeapVector<RuleData>* rules = rule_set.IdRules(str);
   ASSERT_EQ(1u, rules->size());
-  ASSERT_EQ(str, rules->at(0)->Selector().Value());
+  ASSERT_EQ(str, rules->at(0).Selector().Value());
 }
 
 TEST(RuleSetTest, findBestRuleSetAndAdd_AttrThenId) {
@@ -114,10 +113,10 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_AttrThenId) {
   sheet.AddCSSRules("[attr]#id { }");
   RuleSet& rule_set = sheet.GetRuleSet();
   AtomicString str("id");
-  const HeapVector<Member<const RuleData>>* rules = rule_set.IdRules(str);
+  const HeapVector<RuleData>* rules = rule_set.IdRules(str);
   ASSERT_EQ(1u, rules->size());
   AtomicString attr_str("attr");
-  ASSERT_EQ(attr_str, rules->at(0)->Selector().Attribute().LocalName());
+  ASSERT_EQ(attr_str, rules->at(0).Selector().Attribute().LocalName());
 }
 
 TEST(RuleSetTest, findBestRuleSetAndAdd_TagThenAttrThenId) {
@@ -126,10 +125,10 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_TagThenAttrThenId) {
   sheet.AddCSSRules("div[attr]#id { }");
   RuleSet& rule_set = sheet.GetRuleSet();
   AtomicString str("id");
-  const HeapVector<Member<const RuleData>>* rules = rule_set.IdRules(str);
+  const HeapVector<RuleData>* rules = rule_set.IdRules(str);
   ASSERT_EQ(1u, rules->size());
   AtomicString tag_str("div");
-  ASSERT_EQ(tag_str, rules->at(0)->Selector().TagQName().LocalName());
+  ASSERT_EQ(tag_str, rules->at(0).Selector().TagQName().LocalName());
 }
 
 TEST(RuleSetTest, findBestRuleSetAndAdd_DivWithContent) {
@@ -138,10 +137,10 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_DivWithContent) {
   sheet.AddCSSRules("div::content { }");
   RuleSet& rule_set = sheet.GetRuleSet();
   AtomicString str("div");
-  const HeapVector<Member<const RuleData>>* rules = rule_set.TagRules(str);
+  const HeapVector<RuleData>* rules = rule_set.TagRules(str);
   ASSERT_EQ(1u, rules->size());
   AtomicString value_str("content");
-  ASSERT_EQ(value_str, rules->at(0)->Selector().TagHistory()->Value());
+  ASSERT_EQ(value_str, rules->at(0).Selector().TagHistory()->Value());
 }
 
 TEST(RuleSetTest, findBestRuleSetAndAdd_Host) {
@@ -149,7 +148,7 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_Host) {
 
   sheet.AddCSSRules(":host { }");
   RuleSet& rule_set = sheet.GetRuleSet();
-  const HeapVector<Member<const RuleData>>* rules = rule_set.ShadowHostRules();
+  const HeapVector<RuleData>* rules = rule_set.ShadowHostRules();
   ASSERT_EQ(1u, rules->size());
 }
 
@@ -158,7 +157,7 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_HostWithId) {
 
   sheet.AddCSSRules(":host(#x) { }");
   RuleSet& rule_set = sheet.GetRuleSet();
-  const HeapVector<Member<const RuleData>>* rules = rule_set.ShadowHostRules();
+  const HeapVector<RuleData>* rules = rule_set.ShadowHostRules();
   ASSERT_EQ(1u, rules->size());
 }
 
@@ -167,7 +166,7 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_HostContext) {
 
   sheet.AddCSSRules(":host-context(*) { }");
   RuleSet& rule_set = sheet.GetRuleSet();
-  const HeapVector<Member<const RuleData>>* rules = rule_set.ShadowHostRules();
+  const HeapVector<RuleData>* rules = rule_set.ShadowHostRules();
   ASSERT_EQ(1u, rules->size());
 }
 
@@ -176,7 +175,7 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_HostContextWithId) {
 
   sheet.AddCSSRules(":host-context(#x) { }");
   RuleSet& rule_set = sheet.GetRuleSet();
-  const HeapVector<Member<const RuleData>>* rules = rule_set.ShadowHostRules();
+  const HeapVector<RuleData>* rules = rule_set.ShadowHostRules();
   ASSERT_EQ(1u, rules->size());
 }
 
@@ -185,11 +184,9 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_HostAndHostContextNotInRightmost) {
 
   sheet.AddCSSRules(":host-context(#x) .y, :host(.a) > #b  { }");
   RuleSet& rule_set = sheet.GetRuleSet();
-  const HeapVector<Member<const RuleData>>* shadow_rules =
-      rule_set.ShadowHostRules();
-  const HeapVector<Member<const RuleData>>* id_rules = rule_set.IdRules("b");
-  const HeapVector<Member<const RuleData>>* class_rules =
-      rule_set.ClassRules("y");
+  const HeapVector<RuleData>* shadow_rules = rule_set.ShadowHostRules();
+  const HeapVector<RuleData>* id_rules = rule_set.IdRules("b");
+  const HeapVector<RuleData>* class_rules = rule_set.ClassRules("y");
   ASSERT_EQ(0u, shadow_rules->size());
   ASSERT_EQ(1u, id_rules->size());
   ASSERT_EQ(1u, class_rules->size());
@@ -200,7 +197,7 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_HostAndClass) {
 
   sheet.AddCSSRules(".foo:host { }");
   RuleSet& rule_set = sheet.GetRuleSet();
-  const HeapVector<Member<const RuleData>>* rules = rule_set.ShadowHostRules();
+  const HeapVector<RuleData>* rules = rule_set.ShadowHostRules();
   ASSERT_EQ(0u, rules->size());
 }
 
@@ -209,7 +206,7 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_HostContextAndClass) {
 
   sheet.AddCSSRules(".foo:host-context(*) { }");
   RuleSet& rule_set = sheet.GetRuleSet();
-  const HeapVector<Member<const RuleData>>* rules = rule_set.ShadowHostRules();
+  const HeapVector<RuleData>* rules = rule_set.ShadowHostRules();
   ASSERT_EQ(0u, rules->size());
 }
 
@@ -219,8 +216,7 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_Focus) {
   sheet.AddCSSRules(":focus { }");
   sheet.AddCSSRules("[attr]:focus { }");
   RuleSet& rule_set = sheet.GetRuleSet();
-  const HeapVector<Member<const RuleData>>* rules =
-      rule_set.FocusPseudoClassRules();
+  const HeapVector<RuleData>* rules = rule_set.FocusPseudoClassRules();
   ASSERT_EQ(2u, rules->size());
 }
 
@@ -234,8 +230,7 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_LinkVisited) {
   sheet.AddCSSRules(":-webkit-any-link { }");
   sheet.AddCSSRules("[attr]:-webkit-any-link { }");
   RuleSet& rule_set = sheet.GetRuleSet();
-  const HeapVector<Member<const RuleData>>* rules =
-      rule_set.LinkPseudoClassRules();
+  const HeapVector<RuleData>* rules = rule_set.LinkPseudoClassRules();
   ASSERT_EQ(6u, rules->size());
 }
 
@@ -245,7 +240,7 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_Cue) {
   sheet.AddCSSRules("::cue(b) { }");
   sheet.AddCSSRules("video::cue(u) { }");
   RuleSet& rule_set = sheet.GetRuleSet();
-  const HeapVector<Member<const RuleData>>* rules = rule_set.CuePseudoRules();
+  const HeapVector<RuleData>* rules = rule_set.CuePseudoRules();
   ASSERT_EQ(2u, rules->size());
 }
 
@@ -266,21 +261,21 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_PseudoIs) {
   RuleSet& rule_set = sheet.GetRuleSet();
   {
     AtomicString str("c");
-    const HeapVector<Member<const RuleData>>* rules = rule_set.ClassRules(str);
+    const HeapVector<RuleData>* rules = rule_set.ClassRules(str);
     ASSERT_EQ(1u, rules->size());
-    ASSERT_EQ(str, rules->at(0)->Selector().Value());
+    ASSERT_EQ(str, rules->at(0).Selector().Value());
   }
   {
     AtomicString str("e");
-    const HeapVector<Member<const RuleData>>* rules = rule_set.ClassRules(str);
+    const HeapVector<RuleData>* rules = rule_set.ClassRules(str);
     ASSERT_EQ(1u, rules->size());
-    ASSERT_EQ(str, rules->at(0)->Selector().Value());
+    ASSERT_EQ(str, rules->at(0).Selector().Value());
   }
   {
     AtomicString str("f");
-    const HeapVector<Member<const RuleData>>* rules = rule_set.ClassRules(str);
+    const HeapVector<RuleData>* rules = rule_set.ClassRules(str);
     ASSERT_EQ(1u, rules->size());
-    ASSERT_EQ(str, rules->at(0)->Selector().Value());
+    ASSERT_EQ(str, rules->at(0).Selector().Value());
   }
 }
 
@@ -291,21 +286,21 @@ TEST(RuleSetTest, findBestRuleSetAndAdd_PseudoWhere) {
   RuleSet& rule_set = sheet.GetRuleSet();
   {
     AtomicString str("c");
-    const HeapVector<Member<const RuleData>>* rules = rule_set.ClassRules(str);
+    const HeapVector<RuleData>* rules = rule_set.ClassRules(str);
     ASSERT_EQ(1u, rules->size());
-    ASSERT_EQ(str, rules->at(0)->Selector().Value());
+    ASSERT_EQ(str, rules->at(0).Selector().Value());
   }
   {
     AtomicString str("e");
-    const HeapVector<Member<const RuleData>>* rules = rule_set.ClassRules(str);
+    const HeapVector<RuleData>* rules = rule_set.ClassRules(str);
     ASSERT_EQ(1u, rules->size());
-    ASSERT_EQ(str, rules->at(0)->Selector().Value());
+    ASSERT_EQ(str, rules->at(0).Selector().Value());
   }
   {
     AtomicString str("f");
-    const HeapVector<Member<const RuleData>>* rules = rule_set.ClassRules(str);
+    const HeapVector<RuleData>* rules = rule_set.ClassRules(str);
     ASSERT_EQ(1u, rules->size());
-    ASSERT_EQ(str, rules->at(0)->Selector().Value());
+    ASSERT_EQ(str, rules->at(0).Selector().Value());
   }
 }
 
@@ -363,9 +358,9 @@ TEST(RuleSetTest, SelectorIndexLimit) {
   TestStyleSheet sheet;
   sheet.AddCSSRules(builder.ToString());
   const RuleSet& rule_set = sheet.GetRuleSet();
-  const HeapVector<Member<const RuleData>>* rules = rule_set.TagRules("b");
+  const HeapVector<RuleData>* rules = rule_set.TagRules("b");
   ASSERT_EQ(1u, rules->size());
-  EXPECT_EQ("b", rules->at(0)->Selector().TagQName().LocalName());
+  EXPECT_EQ("b", rules->at(0).Selector().TagQName().LocalName());
   EXPECT_FALSE(rule_set.TagRules("span"));
 }
 
@@ -373,22 +368,53 @@ TEST(RuleSetTest, RuleDataSelectorIndexLimit) {
   StyleRule* rule = CreateDummyStyleRule();
   AddRuleFlags flags = kRuleHasNoSpecialState;
   const unsigned position = 0;
-  EXPECT_TRUE(RuleData::MaybeCreate(rule, 0, position, flags));
-  EXPECT_FALSE(RuleData::MaybeCreate(rule, (1 << RuleData::kSelectorIndexBits),
-                                     position, flags));
-  EXPECT_FALSE(RuleData::MaybeCreate(
-      rule, (1 << RuleData::kSelectorIndexBits) + 1, position, flags));
+  const unsigned limit = 1 << RuleData::kSelectorIndexBits;
+  EXPECT_TRUE(RuleData::MaybeCreate(rule, 0, position, flags).has_value());
+  EXPECT_FALSE(RuleData::MaybeCreate(rule, limit, position, flags).has_value());
+  EXPECT_FALSE(
+      RuleData::MaybeCreate(rule, limit + 1, position, flags).has_value());
 }
 
 TEST(RuleSetTest, RuleDataPositionLimit) {
   StyleRule* rule = CreateDummyStyleRule();
   AddRuleFlags flags = kRuleHasNoSpecialState;
   const unsigned selector_index = 0;
-  EXPECT_TRUE(RuleData::MaybeCreate(rule, selector_index, 0, flags));
-  EXPECT_FALSE(RuleData::MaybeCreate(rule, selector_index,
-                                     (1 << RuleData::kPositionBits), flags));
-  EXPECT_FALSE(RuleData::MaybeCreate(
-      rule, selector_index, (1 << RuleData::kPositionBits) + 1, flags));
+  const unsigned limit = 1 << RuleData::kPositionBits;
+  EXPECT_TRUE(
+      RuleData::MaybeCreate(rule, selector_index, 0, flags).has_value());
+  EXPECT_FALSE(
+      RuleData::MaybeCreate(rule, selector_index, limit, flags).has_value());
+  EXPECT_FALSE(RuleData::MaybeCreate(rule, selector_index, limit + 1, flags)
+                   .has_value());
+}
+
+TEST(RuleSetTest, CompactedRuleDataStoresSelectorFingerprint) {
+  TestStyleSheet sheet;
+
+  sheet.AddCSSRules("#outer .inner { }");
+  sheet.AddCSSRules(".inner { }");
+  RuleSet& rule_set = sheet.GetRuleSet();
+  const HeapVector<RuleData>* rules = rule_set.ClassRules("inner");
+  ASSERT_EQ(2u, rules->size());
+
+  // Rules are stored inline in the bucket, with the specificity and the
+  // ancestor identifier hashes precomputed for the fast reject.
+  const RuleData* descendant_rule = nullptr;
+  const RuleData* simple_rule = nullptr;
+  for (const RuleData& rule_data : *rules) {
+    if (rule_data.Selector().TagHistory())
+      descendant_rule = &rule_data;
+    else
+      simple_rule = &rule_data;
+  }
+  ASSERT_TRUE(descendant_rule);
+  ASSERT_TRUE(simple_rule);
+  EXPECT_EQ(descendant_rule->Selector().Specificity(),
+            descendant_rule->Specificity());
+  EXPECT_NE(0u, descendant_rule->DescendantSelectorIdentifierHashes()[0]);
+  EXPECT_EQ(0u, descendant_rule->DescendantSelectorIdentifierHashes()[1]);
+  EXPECT_EQ(0u, simple_rule->DescendantSelectorIdentifierHashes()[0]);
+  EXPECT_EQ(&rules->at(0) + 1, &rules->at(1));
 }
 
 TEST(RuleSetTest, RuleCountNotIncreasedByInvalidRuleData) {
@@ -30,8 +30,14 @@
 
 #include "third_party/blink/renderer/core/css/selector_filter.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "third_party/blink/renderer/core/css/css_selector.h"
+#include "third_party/blink/renderer/core/css/resolver/style_resolver_stats.h"
+#include "third_party/blink/renderer/core/css/style_engine.h"
 #include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 
 namespace blink {
 
@@ -62,8 +68,56 @@ static inline void CollectElementIdentifierHashes(
   }
 }
 
-void SelectorFilter::PushParentStackFrame(Element& parent) {
+static double EstimatedFalsePositiveRate(wtf_size_t identifier_count,
+                                         size_t table_size) {
+  // See BloomFilter: (1-e^(-2n/m))^2 for k=2.
+  double fill = 1 - std::exp(-2.0 * identifier_count / table_size);
+  return fill * fill;
+}
+
+void SelectorFilter::AddIdentifierHashes(const ParentStackFrame& frame) {
+  if (UNLIKELY(wide_ancestor_identifier_filter_)) {
+    for (unsigned hash : frame.identifier_hashes)
+      wide_ancestor_identifier_filter_->Add(hash);
+  } else {
+    DCHECK(ancestor_identifier_filter_);
+    for (unsigned hash : frame.identifier_hashes)
+      ancestor_identifier_filter_->Add(hash);
+  }
+  identifier_count_ += frame.identifier_hashes.size();
+  peak_identifier_count_ = std::max(peak_identifier_count_, identifier_count_);
+}
+
+void SelectorFilter::RemoveIdentifierHashes(const ParentStackFrame& frame) {
+  if (UNLIKELY(wide_ancestor_identifier_filter_)) {
+    for (unsigned hash : frame.identifier_hashes)
+      wide_ancestor_identifier_filter_->Remove(hash);
+  } else {
+    DCHECK(ancestor_identifier_filter_);
+    for (unsigned hash : frame.identifier_hashes)
+      ancestor_identifier_filter_->Remove(hash);
+  }
+  DCHECK_GE(identifier_count_, frame.identifier_hashes.size());
+  identifier_count_ -= frame.identifier_hashes.size();
+}
+
+void SelectorFilter::WidenFilter(Document& document) {
   DCHECK(ancestor_identifier_filter_);
+  DCHECK(!wide_ancestor_identifier_filter_);
+  // Rebuild from the identifiers kept on the parent stack rather than copying
+  // the narrow table, which has already saturated.
+  ancestor_identifier_filter_.reset();
+  wide_ancestor_identifier_filter_ = std::make_unique<WideIdentifierFilter>();
+  for (const ParentStackFrame& frame : parent_stack_) {
+    for (unsigned hash : frame.identifier_hashes)
+      wide_ancestor_identifier_filter_->Add(hash);
+  }
+  INCREMENT_STYLE_STATS_COUNTER(document.GetStyleEngine(),
+                                selector_filter_widened, 1);
+}
+
+void SelectorFilter::PushParentStackFrame(Element& parent) {
+  DCHECK(ancestor_identifier_filter_ || wide_ancestor_identifier_filter_);
   DCHECK(parent_stack_.IsEmpty() ||
          parent_stack_.back().element == parent.ParentOrShadowHostElement());
   DCHECK(!parent_stack_.IsEmpty() || !parent.ParentOrShadowHostElement());
@@ -72,25 +126,49 @@ void SelectorFilter::PushParentStackFrame(Element& parent) {
   // Mix tags, class names and ids into some sort of weird bouillabaisse.
   // The filter is used for fast rejection of child and descendant selectors.
   CollectElementIdentifierHashes(parent, parent_frame.identifier_hashes);
-  wtf_size_t count = parent_frame.identifier_hashes.size();
-  for (wtf_size_t i = 0; i < count; ++i)
-    ancestor_identifier_filter_->Add(parent_frame.identifier_hashes[i]);
+  AddIdentifierHashes(parent_frame);
+  if (identifier_count_ > kMaximumIdentifiersForNarrowFilter &&
+      !wide_ancestor_identifier_filter_ &&
+      RuntimeEnabledFeatures::AdaptiveSelectorFilterEnabled()) {
+    WidenFilter(parent.GetDocument());
+  }
 }
 
 void SelectorFilter::PopParentStackFrame() {
   DCHECK(!parent_stack_.IsEmpty());
-  DCHECK(ancestor_identifier_filter_);
   const ParentStackFrame& parent_frame = parent_stack_.back();
-  wtf_size_t count = parent_frame.identifier_hashes.size();
-  for (wtf_size_t i = 0; i < count; ++i)
-    ancestor_identifier_filter_->Remove(parent_frame.identifier_hashes[i]);
+  RemoveIdentifierHashes(parent_frame);
+  if (parent_stack_.size() > 1) {
+    parent_stack_.pop_back();
+    return;
+  }
+
+  Document& document = parent_frame.element->GetDocument();
+  size_t table_size = wide_ancestor_identifier_filter_
+                          ? WideIdentifierFilter::kTableSize
+                          : IdentifierFilter::kTableSize;
+  if (StyleResolverStats* stats = document.GetStyleEngine().Stats()) {
+    stats->selector_filter_peak_identifiers =
+        std::max<unsigned>(stats->selector_filter_peak_identifiers,
+                           peak_identifier_count_);
+    stats->selector_filter_false_positive_rate =
+        std::max(stats->selector_filter_false_positive_rate,
+                 EstimatedFalsePositiveRate(peak_identifier_count_,
+                                            table_size));
+  }
   parent_stack_.pop_back();
-  if (parent_stack_.IsEmpty()) {
 #if DCHECK_IS_ON()
-    DCHECK(ancestor_identifier_filter_->LikelyEmpty());
+  DCHECK(!ancestor_identifier_filter_ ||
+         ancestor_identifier_filter_->LikelyEmpty());
+  DCHECK(!wide_ancestor_identifier_filter_ ||
+         wide_ancestor_identifier_filter_->LikelyEmpty());
 #endif
-    ancestor_identifier_filter_.reset();
-  }
+  DCHECK(!identifier_count_);
+  prefer_wide_filter_ =
+      peak_identifier_count_ > kMaximumIdentifiersForNarrowFilter;
+  peak_identifier_count_ = 0;
+  ancestor_identifier_filter_.reset();
+  wide_ancestor_identifier_filter_.reset();
 }
 
 void SelectorFilter::PushParent(Element& parent) {
@@ -99,11 +177,18 @@ void SelectorFilter::PushParent(Element& parent) {
   if (parent_stack_.IsEmpty()) {
     DCHECK_EQ(parent, parent.GetDocument().documentElement());
     DCHECK(!ancestor_identifier_filter_);
-    ancestor_identifier_filter_ = std::make_unique<IdentifierFilter>();
+    DCHECK(!wide_ancestor_identifier_filter_);
+    if (prefer_wide_filter_ &&
+        RuntimeEnabledFeatures::AdaptiveSelectorFilterEnabled()) {
+      wide_ancestor_identifier_filter_ =
+          std::make_unique<WideIdentifierFilter>();
+    } else {
+      ancestor_identifier_filter_ = std::make_unique<IdentifierFilter>();
+    }
     PushParentStackFrame(parent);
     return;
   }
-  DCHECK(ancestor_identifier_filter_);
+  DCHECK(ancestor_identifier_filter_ || wide_ancestor_identifier_filter_);
   // We may get invoked for some random elements in some wacky cases during
   // style resolve. Pause maintaining the stack in this case.
   if (parent_stack_.back().element != parent.ParentOrShadowHostElement())
@@ -81,27 +81,66 @@ class CORE_EXPORT SelectorFilter {
   void PushParentStackFrame(Element& parent);
   void PopParentStackFrame();
 
+  void AddIdentifierHashes(const ParentStackFrame&);
+  void RemoveIdentifierHashes(const ParentStackFrame&);
+  void WidenFilter(Document&);
+
+  template <unsigned maximumIdentifierCount, typename Filter>
+  static inline bool FastRejectSelectorWithFilter(
+      const Filter&,
+      const unsigned* identifier_hashes);
+
   HeapVector<ParentStackFrame> parent_stack_;
 
   // With 100 unique strings in the filter, 2^12 slot table has false positive
   // rate of ~0.2%.
   using IdentifierFilter = BloomFilter<12>;
   std::unique_ptr<IdentifierFilter> ancestor_identifier_filter_;
+
+  // With the AdaptiveSelectorFilter runtime feature, the ancestor filter is
+  // swapped for a 2^16 slot table once the ancestor chain holds more than
+  // kMaximumIdentifiersForNarrowFilter identifiers (~1.4% false positives). The
+  // wide table has a false positive rate of ~0.4% with 2000 unique strings.
+  // Only one of the two filters exists at any time.
+  using WideIdentifierFilter = BloomFilter<16>;
+  static constexpr wtf_size_t kMaximumIdentifiersForNarrowFilter = 256;
+  std::unique_ptr<WideIdentifierFilter> wide_ancestor_identifier_filter_;
+
+  // Number of identifier hashes currently added to the ancestor filter, and
+  // the largest such number seen since the filter was created.
+  wtf_size_t identifier_count_ = 0;
+  wtf_size_t peak_identifier_count_ = 0;
+  // Set when the previous style recalc needed the wide filter, so that the
+  // next one starts out with it instead of rebuilding it half-way.
+  bool prefer_wide_filter_ = false;
+
   DISALLOW_COPY_AND_ASSIGN(SelectorFilter);
 };
 
-template <unsigned maximumIdentifierCount>
-inline bool SelectorFilter::FastRejectSelector(
-    const unsigned* identifier_hashes) const {
-  DCHECK(ancestor_identifier_filter_);
+template <unsigned maximumIdentifierCount, typename Filter>
+inline bool SelectorFilter::FastRejectSelectorWithFilter(
+    const Filter& filter,
+    const unsigned* identifier_hashes) {
   for (unsigned n = 0; n < maximumIdentifierCount && identifier_hashes[n];
        ++n) {
-    if (!ancestor_identifier_filter_->MayContain(identifier_hashes[n]))
+    if (!filter.MayContain(identifier_hashes[n]))
       return true;
   }
   return false;
 }
 
+template <unsigned maximumIdentifierCount>
+inline bool SelectorFilter::FastRejectSelector(
+    const unsigned* identifier_hashes) const {
+  if (UNLIKELY(wide_ancestor_identifier_filter_)) {
+    return FastRejectSelectorWithFilter<maximumIdentifierCount>(
+        *wide_ancestor_identifier_filter_, identifier_hashes);
+  }
+  DCHECK(ancestor_identifier_filter_);
+  return FastRejectSelectorWithFilter<maximumIdentifierCount>(
+      *ancestor_identifier_filter_, identifier_hashes);
+}
+
 }  // namespace blink
 
 WTF_ALLOW_INIT_WITH_MEM_FUNCTIONS(blink::SelectorFilter::ParentStackFrame)
@@ -41,6 +41,7 @@
 #include "third_party/blink/renderer/core/html_names.h"
 #include "third_party/blink/renderer/platform/bindings/exception_state.h"
 #include "third_party/blink/renderer/platform/heap/heap.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 
 // Uncomment to run the SelectorQueryTests for stats in a release build.
 // #define RELEASE_QUERY_STATS
@@ -146,17 +147,17 @@ Element* SelectorQuery::QueryFirst(ContainerNode& root_node) const {
   return matched_element;
 }
 
-template <typename SelectorQueryTrait>
+template <typename SelectorQueryTrait, typename MatchesFunction>
 static void CollectElementsByClassName(
     ContainerNode& root_node,
     const AtomicString& class_name,
-    const CSSSelector* selector,
+    const MatchesFunction& matches,
     typename SelectorQueryTrait::OutputType& output) {
   for (Element& element : ElementTraversal::DescendantsOf(root_node)) {
     QUERY_STATS_INCREMENT(fast_class);
     if (!element.HasClassName(class_name))
       continue;
-    if (selector && !SelectorMatches(*selector, element, root_node))
+    if (!matches(element))
       continue;
     SelectorQueryTrait::AppendElement(output, element);
     if (SelectorQueryTrait::kShouldOnlyMatchFirstElement)
@@ -179,6 +180,95 @@ inline bool MatchesTagName(const QualifiedName& tag_name,
   return false;
 }
 
+bool CompiledSelector::Compile(const CSSSelector& selector) {
+  DCHECK(program_.IsEmpty());
+  for (const CSSSelector* current = &selector; current;
+       current = current->TagHistory()) {
+    switch (current->Match()) {
+      case CSSSelector::kTag:
+        if (current->TagQName().NamespaceURI() != g_star_atom)
+          return false;
+        if (current->TagQName() != AnyQName()) {
+          program_.push_back(
+              Instruction{Op::kTag, current->TagQName(), g_null_atom});
+        }
+        break;
+      case CSSSelector::kClass:
+        program_.push_back(
+            Instruction{Op::kClass, QualifiedName::Null(), current->Value()});
+        break;
+      case CSSSelector::kId:
+        program_.push_back(
+            Instruction{Op::kId, QualifiedName::Null(), current->Value()});
+        break;
+      default:
+        return false;
+    }
+    if (current->IsLastInTagHistory())
+      break;
+    switch (current->Relation()) {
+      case CSSSelector::kSubSelector:
+        break;
+      case CSSSelector::kChild:
+        program_.push_back(
+            Instruction{Op::kChild, QualifiedName::Null(), g_null_atom});
+        break;
+      case CSSSelector::kDescendant:
+        program_.push_back(
+            Instruction{Op::kDescendant, QualifiedName::Null(), g_null_atom});
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+bool CompiledSelector::Match(Element& element) const {
+  return MatchFrom(0, element) == kMatches;
+}
+
+// Mirrors SelectorChecker::MatchSelector(), including giving up on the
+// remaining ancestors when a match can't succeed higher up in the tree.
+CompiledSelector::MatchStatus CompiledSelector::MatchFrom(
+    wtf_size_t pc,
+    Element& element) const {
+  for (; pc < program_.size(); ++pc) {
+    const Instruction& instruction = program_[pc];
+    switch (instruction.op) {
+      case Op::kTag:
+        if (!MatchesTagName(instruction.tag_name, element))
+          return kFailsLocally;
+        break;
+      case Op::kClass:
+        if (!element.HasClass() ||
+            !element.ClassNames().Contains(instruction.value))
+          return kFailsLocally;
+        break;
+      case Op::kId:
+        if (!element.HasID() ||
+            element.IdForStyleResolution() != instruction.value)
+          return kFailsLocally;
+        break;
+      case Op::kChild: {
+        Element* parent = element.parentElement();
+        if (!parent)
+          return kFailsCompletely;
+        return MatchFrom(pc + 1, *parent);
+      }
+      case Op::kDescendant:
+        for (Element* ancestor = element.parentElement(); ancestor;
+             ancestor = ancestor->parentElement()) {
+          MatchStatus status = MatchFrom(pc + 1, *ancestor);
+          if (status != kFailsLocally)
+            return status;
+        }
+        return kFailsCompletely;
+    }
+  }
+  return kMatches;
+}
+
 template <typename SelectorQueryTrait>
 static void CollectElementsByTagName(
     ContainerNode& root_node,
@@ -227,7 +317,11 @@ void SelectorQuery::FindTraverseRootsAndExecute(
         selector->Match() == CSSSelector::kClass) {
       if (is_rightmost_selector) {
         CollectElementsByClassName<SelectorQueryTrait>(
-            root_node, selector->Value(), selectors_[0], output);
+            root_node, selector->Value(),
+            [this, &root_node](Element& element) {
+              return SelectorMatchesAt(0, element, root_node);
+            },
+            output);
         return;
       }
       // Since there exists some ancestor element which has the class name, we
@@ -272,6 +366,19 @@ void SelectorQuery::ExecuteForTraverseRoot(
     typename SelectorQueryTrait::OutputType& output) const {
   DCHECK_EQ(selectors_.size(), 1u);
 
+  if (CanUseCompiledSelectors(root_node)) {
+    const CompiledSelector& compiled_selector = compiled_selectors_[0];
+    for (Element& element : ElementTraversal::DescendantsOf(traverse_root)) {
+      QUERY_STATS_INCREMENT(fast_scan);
+      if (compiled_selector.Match(element)) {
+        SelectorQueryTrait::AppendElement(output, element);
+        if (SelectorQueryTrait::kShouldOnlyMatchFirstElement)
+          return;
+      }
+    }
+    return;
+  }
+
   const CSSSelector& selector = *selectors_[0];
 
   for (Element& element : ElementTraversal::DescendantsOf(traverse_root)) {
@@ -286,6 +393,13 @@ void SelectorQuery::ExecuteForTraverseRoot(
 
 bool SelectorQuery::SelectorListMatches(ContainerNode& root_node,
                                         Element& element) const {
+  if (CanUseCompiledSelectors(root_node)) {
+    for (const auto& compiled_selector : compiled_selectors_) {
+      if (compiled_selector.Match(element))
+        return true;
+    }
+    return false;
+  }
   for (auto* const selector : selectors_) {
     if (SelectorMatches(*selector, element, root_node))
       return true;
@@ -293,6 +407,19 @@ bool SelectorQuery::SelectorListMatches(ContainerNode& root_node,
   return false;
 }
 
+bool SelectorQuery::SelectorMatchesAt(wtf_size_t index,
+                                      Element& element,
+                                      const ContainerNode& root_node) const {
+  if (CanUseCompiledSelectors(root_node))
+    return compiled_selectors_[index].Match(element);
+  return SelectorMatches(*selectors_[index], element, root_node);
+}
+
+bool SelectorQuery::CanUseCompiledSelectors(
+    const ContainerNode& root_node) const {
+  return !compiled_selectors_.IsEmpty() && !root_node.IsInShadowTree();
+}
+
 template <typename SelectorQueryTrait>
 void SelectorQuery::ExecuteSlow(
     ContainerNode& root_node,
@@ -365,7 +492,6 @@ void SelectorQuery::ExecuteWithId(
   DCHECK_EQ(selectors_.size(), 1u);
   DCHECK(!root_node.GetDocument().InQuirksMode());
 
-  const CSSSelector& first_selector = *selectors_[0];
   const TreeScope& scope = root_node.ContainingTreeScope();
 
   if (scope.ContainsMultipleElementsWithId(selector_id_)) {
@@ -380,7 +506,7 @@ void SelectorQuery::ExecuteWithId(
       if (!element->IsDescendantOf(&root_node))
         continue;
       QUERY_STATS_INCREMENT(fast_id);
-      if (SelectorMatches(first_selector, *element, root_node)) {
+      if (SelectorMatchesAt(0, *element, root_node)) {
         SelectorQueryTrait::AppendElement(output, *element);
         if (SelectorQueryTrait::kShouldOnlyMatchFirstElement)
           return;
@@ -396,7 +522,7 @@ void SelectorQuery::ExecuteWithId(
     if (!element->IsDescendantOf(&root_node))
       return;
     QUERY_STATS_INCREMENT(fast_id);
-    if (SelectorMatches(first_selector, *element, root_node))
+    if (SelectorMatchesAt(0, *element, root_node))
       SelectorQueryTrait::AppendElement(output, *element);
     return;
   }
@@ -449,7 +575,8 @@ void SelectorQuery::Execute(
     switch (first_selector.Match()) {
       case CSSSelector::kClass:
         CollectElementsByClassName<SelectorQueryTrait>(
-            root_node, first_selector.Value(), nullptr, output);
+            root_node, first_selector.Value(),
+            [](Element&) { return true; }, output);
         return;
       case CSSSelector::kTag:
         if (first_selector.TagQName().NamespaceURI() == g_star_atom) {
@@ -493,6 +620,19 @@ SelectorQuery::SelectorQuery(CSSSelectorList selector_list)
     needs_updated_distribution_ |= selector->NeedsUpdatedDistribution();
   }
 
+  if (RuntimeEnabledFeatures::CompiledSelectorQueryEnabled() &&
+      !uses_deep_combinator_or_shadow_pseudo_ && !needs_updated_distribution_) {
+    compiled_selectors_.ReserveInitialCapacity(selectors_.size());
+    for (const CSSSelector* selector : selectors_) {
+      CompiledSelector compiled_selector;
+      if (!compiled_selector.Compile(*selector)) {
+        compiled_selectors_.clear();
+        break;
+      }
+      compiled_selectors_.UncheckedAppend(std::move(compiled_selector));
+    }
+  }
+
   if (selectors_.size() == 1 && !uses_deep_combinator_or_shadow_pseudo_ &&
       !needs_updated_distribution_) {
     use_slow_scan_ = false;
@@ -31,6 +31,7 @@
 
 #include "base/macros.h"
 #include "third_party/blink/renderer/core/css/css_selector_list.h"
+#include "third_party/blink/renderer/core/dom/qualified_name.h"
 #include "third_party/blink/renderer/platform/heap/handle.h"
 #include "third_party/blink/renderer/platform/wtf/hash_map.h"
 #include "third_party/blink/renderer/platform/wtf/text/atomic_string_hash.h"
@@ -47,6 +48,39 @@ template <typename NodeType>
 class StaticNodeTypeList;
 using StaticElementList = StaticNodeTypeList<Element>;
 
+// A selector compiled to a flat program of simple checks, for selectors made
+// of type, class and id selectors combined with descendant and child
+// combinators. Matching such a program avoids setting up a SelectorChecker for
+// every candidate element. The program is only equivalent to SelectorChecker
+// for queries rooted outside shadow trees, where the ancestor chain is the
+// parentElement() chain.
+class CORE_EXPORT CompiledSelector {
+  DISALLOW_NEW();
+
+ public:
+  // Returns false if |selector| can't be compiled.
+  bool Compile(const CSSSelector&);
+
+  bool Match(Element&) const;
+
+ private:
+  enum class Op : uint8_t { kTag, kClass, kId, kChild, kDescendant };
+  enum MatchStatus { kMatches, kFailsLocally, kFailsCompletely };
+
+  struct Instruction {
+    Op op;
+    // The tag name for kTag.
+    QualifiedName tag_name = QualifiedName::Null();
+    // The class name for kClass, or the id for kId.
+    AtomicString value;
+  };
+
+  MatchStatus MatchFrom(wtf_size_t pc, Element&) const;
+
+  // The compound selectors from right to left, separated by combinators.
+  Vector<Instruction> program_;
+};
+
 class CORE_EXPORT SelectorQuery {
   USING_FAST_MALLOC(SelectorQuery);
 
@@ -79,6 +113,8 @@ class CORE_EXPORT SelectorQuery {
   // non DCHECK builds to avoid the overhead on the query process.
   static QueryStats LastQueryStats();
 
+  bool UsesCompiledSelectors() const { return !compiled_selectors_.IsEmpty(); }
+
  private:
   explicit SelectorQuery(CSSSelectorList);
 
@@ -105,6 +141,10 @@ class CORE_EXPORT SelectorQuery {
                typename SelectorQueryTrait::OutputType&) const;
 
   bool SelectorListMatches(ContainerNode& root_node, Element&) const;
+  bool SelectorMatchesAt(wtf_size_t index,
+                         Element&,
+                         const ContainerNode& root_node) const;
+  bool CanUseCompiledSelectors(const ContainerNode& root_node) const;
 
   CSSSelectorList selector_list_;
   // Contains the list of CSSSelector's to match, but without ones that could
@@ -112,6 +152,8 @@ class CORE_EXPORT SelectorQuery {
   // |selector_list_| will never be empty as SelectorQueryCache::add would have
   // thrown an exception.
   Vector<const CSSSelector*> selectors_;
+  // The compiled |selectors_|. Empty unless all of them could be compiled.
+  Vector<CompiledSelector> compiled_selectors_;
   AtomicString selector_id_;
   bool selector_id_is_rightmost_ : 1;
   bool selector_id_affected_by_sibling_combinator_ : 1;
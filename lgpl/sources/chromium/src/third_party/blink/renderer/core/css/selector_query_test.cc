@@ -17,6 +17,7 @@
 #include "third_party/blink/renderer/core/html/html_document.h"
 #include "third_party/blink/renderer/core/html/html_html_element.h"
 #include "third_party/blink/renderer/platform/heap/heap.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
 
 // Uncomment to run the SelectorQueryTests for stats in a release build.
 // #define RELEASE_QUERY_STATS
@@ -61,6 +62,18 @@ void RunTests(ContainerNode& scope, const QueryTest (&test_cases)[length]) {
 #endif
   }
 }
+
+std::unique_ptr<SelectorQuery> CreateSelectorQuery(const Document& document,
+                                                   const char* selector) {
+  CSSSelectorList selector_list = CSSParser::ParseSelector(
+      MakeGarbageCollected<CSSParserContext>(
+          document, NullURL(), true /* origin_clean */,
+          network::mojom::ReferrerPolicy::kDefault, WTF::TextEncoding(),
+          CSSParserContext::kSnapshotProfile),
+      nullptr, selector);
+  return SelectorQuery::Adopt(std::move(selector_list));
+}
+
 }  // namespace
 
 TEST(SelectorQueryTest, NotMatchingPseudoElement) {
@@ -384,4 +397,73 @@ TEST(SelectorQueryTest, DisconnectedTreeScope) {
   RunTests(shadowRoot, kTestCases);
 }
 
+TEST(SelectorQueryTest, CompiledSelectors) {
+  auto* document = MakeGarbageCollected<HTMLDocument>();
+  document->write(R"HTML(
+    <!DOCTYPE html>
+    <html>
+      <head></head>
+      <body>
+        <div id=outer class="a">
+          <section class=b>
+            <p id=first class="c d"></p>
+            <span><p class=c></p></span>
+          </section>
+          <svg><foreignObject class=c></foreignObject></svg>
+        </div>
+        <p id=last class=d></p>
+      </body>
+    </html>
+  )HTML");
+
+  static const struct {
+    const char* selector;
+    bool compiled;
+  } kTestCases[] = {
+      {"p", true},
+      {"div p", true},
+      {".a > section > p", true},
+      {".b p.c", true},
+      {"div > p", true},
+      {"section .c.d", true},
+      {"#outer .c", true},
+      {"* > #first", true},
+      {"body > .d", true},
+      {"foreignObject", true},
+      {"div .c, span > p", true},
+      {"span p, #last", true},
+      {"p:first-child", false},
+      {"[id] p", false},
+      {"section + p", false},
+      {"div p, p:first-child", false},
+  };
+
+  for (const auto& test_case : kTestCases) {
+    SCOPED_TRACE(test_case.selector);
+    std::unique_ptr<SelectorQuery> query;
+    {
+      ScopedCompiledSelectorQueryForTest scoped_feature(false);
+      query = CreateSelectorQuery(*document, test_case.selector);
+    }
+    ScopedCompiledSelectorQueryForTest scoped_feature(true);
+    std::unique_ptr<SelectorQuery> compiled_query =
+        CreateSelectorQuery(*document, test_case.selector);
+    EXPECT_FALSE(query->UsesCompiledSelectors());
+    EXPECT_EQ(test_case.compiled, compiled_query->UsesCompiledSelectors());
+
+    StaticElementList* expected = query->QueryAll(*document);
+    StaticElementList* result = compiled_query->QueryAll(*document);
+    ASSERT_EQ(expected->length(), result->length());
+    for (unsigned i = 0; i < expected->length(); ++i)
+      EXPECT_EQ(expected->item(i), result->item(i));
+    EXPECT_EQ(query->QueryFirst(*document->body()),
+              compiled_query->QueryFirst(*document->body()));
+
+    for (Element& element : ElementTraversal::DescendantsOf(*document)) {
+      EXPECT_EQ(query->Matches(element), compiled_query->Matches(element));
+      EXPECT_EQ(query->Closest(element), compiled_query->Closest(element));
+    }
+  }
+}
+
 }  // namespace blink
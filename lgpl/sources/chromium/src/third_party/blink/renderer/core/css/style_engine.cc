@@ -82,6 +82,7 @@
 #include "third_party/blink/renderer/platform/heap/heap.h"
 #include "third_party/blink/renderer/platform/instrumentation/histogram.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 #include "third_party/blink/renderer/platform/wtf/vector.h"
 
 namespace blink {
@@ -583,6 +584,8 @@ void StyleEngine::ShadowRootRemovedFromDocument(ShadowRoot* shadow_root) {
   active_tree_scopes_.erase(shadow_root);
   dirty_tree_scopes_.erase(shadow_root);
   tree_scopes_removed_ = true;
+  if (global_rule_set_ && shadow_root->GetScopedStyleResolver())
+    global_rule_set_->MarkDirty();
   ResetAuthorStyle(*shadow_root);
 }
 
@@ -597,8 +600,6 @@ void StyleEngine::ResetAuthorStyle(TreeScope& tree_scope) {
   if (!scoped_resolver)
     return;
 
-  if (global_rule_set_)
-    global_rule_set_->MarkDirty();
   if (tree_scope.RootNode().IsDocumentNode()) {
     scoped_resolver->ResetAuthorStyle();
     return;
@@ -1182,7 +1183,8 @@ void StyleEngine::ScheduleCustomElementInvalidations(
 
 void StyleEngine::InvalidateStyle() {
   StyleInvalidator style_invalidator(
-      pending_invalidations_.GetPendingInvalidationMap());
+      pending_invalidations_.GetPendingInvalidationMap(),
+      invalidation_set_profiler_);
   style_invalidator.Invalidate(GetDocument(),
                                style_invalidation_root_.RootElement());
   style_invalidation_root_.Clear();
@@ -1261,6 +1263,16 @@ void StyleEngine::SetStatsEnabled(bool enabled) {
     style_resolver_stats_->Reset();
 }
 
+void StyleEngine::SetInvalidationSetProfilingEnabled(bool enabled) {
+  if (!enabled) {
+    invalidation_set_profiler_ = nullptr;
+    return;
+  }
+  if (!invalidation_set_profiler_)
+    invalidation_set_profiler_ =
+        MakeGarbageCollected<InvalidationSetProfiler>();
+}
+
 void StyleEngine::SetPreferredStylesheetSetNameIfNotSet(const String& name) {
   DCHECK(!name.IsEmpty());
   if (!preferred_stylesheet_set_name_.IsEmpty())
@@ -1381,6 +1393,23 @@ unsigned GetRuleSetFlags(const HeapHashSet<Member<RuleSet>> rule_sets) {
   return flags;
 }
 
+// Returns true if |new_style_sheets| is |old_style_sheets| with some of the
+// sheets removed, and the remaining sheets have the same RuleSets.
+bool ActiveSheetsOnlyRemoved(const ActiveStyleSheetVector& old_style_sheets,
+                             const ActiveStyleSheetVector& new_style_sheets) {
+  if (new_style_sheets.size() >= old_style_sheets.size())
+    return false;
+  HeapHashMap<Member<CSSStyleSheet>, Member<RuleSet>> old_rule_sets;
+  for (const auto& active_sheet : old_style_sheets)
+    old_rule_sets.Set(active_sheet.first, active_sheet.second);
+  for (const auto& active_sheet : new_style_sheets) {
+    auto it = old_rule_sets.find(active_sheet.first);
+    if (it == old_rule_sets.end() || it->value != active_sheet.second)
+      return false;
+  }
+  return true;
+}
+
 }  // namespace
 
 void StyleEngine::InvalidateForRuleSetChanges(
@@ -1490,8 +1519,23 @@ void StyleEngine::ApplyRuleSetChanges(
   if (change == kNoActiveSheetsChanged)
     return;
 
-  // With rules added or removed, we need to re-aggregate rule meta data.
-  global_rule_set_->MarkDirty();
+  // With rules added or removed, we need to re-aggregate rule meta data. When
+  // sheets were only appended or removed, the aggregated rule meta data is
+  // updated for the changed sheets instead.
+  bool incremental_features =
+      RuntimeEnabledFeatures::IncrementalRuleFeatureSetEnabled() &&
+      !global_rule_set_->IsDirty();
+  bool append_features =
+      incremental_features && change == kActiveSheetsAppended;
+  if (incremental_features && change == kActiveSheetsChanged &&
+      ActiveSheetsOnlyRemoved(old_style_sheets, new_style_sheets)) {
+    unsigned removed_rule_count = 0;
+    for (const auto& rule_set : changed_rule_sets)
+      removed_rule_count += rule_set->RuleCount();
+    global_rule_set_->RemovedRuleSets(removed_rule_count);
+  } else if (!append_features) {
+    global_rule_set_->MarkDirty();
+  }
 
   if (changed_rule_flags & kKeyframesRules)
     ScopedStyleResolver::KeyframesRulesAdded(tree_scope);
@@ -1529,8 +1573,12 @@ void StyleEngine::ApplyRuleSetChanges(
   }
 
   if (!new_style_sheets.IsEmpty()) {
+    RuleFeatureSet appended_features;
     tree_scope.EnsureScopedStyleResolver().AppendActiveStyleSheets(
-        append_start_index, new_style_sheets);
+        append_start_index, new_style_sheets,
+        append_features ? &appended_features : nullptr);
+    if (append_features)
+      global_rule_set_->AddAppendedFeatures(appended_features);
   }
 
   InvalidateForRuleSetChanges(tree_scope, changed_rule_sets, changed_rule_flags,
@@ -1776,11 +1824,37 @@ scoped_refptr<StyleInitialData> StyleEngine::MaybeCreateAndGetInitialData() {
   return initial_data_;
 }
 
+// Counts the dirty child subtrees of the style recalc root, and how many of
+// them could have their style resolved without looking at their siblings. This
+// is only reported through the stats, as an upper bound on how much of a recalc
+// could be partitioned into independent units of work. Actually resolving the
+// partitions elsewhere than on the main thread is not possible since style
+// resolution reads and writes objects on the main thread heap (Elements,
+// RuleSets, the MatchedPropertiesCache, ...).
+static void CountRecalcSubtrees(const Element& root,
+                                StyleResolverStats& stats) {
+  bool siblings_dependent = root.ChildrenAffectedByDirectAdjacentRules() ||
+                            root.ChildrenAffectedByIndirectAdjacentRules() ||
+                            root.ChildrenAffectedByForwardPositionalRules() ||
+                            root.ChildrenAffectedByBackwardPositionalRules();
+  for (const Element* child = ElementTraversal::FirstChild(root); child;
+       child = ElementTraversal::NextSibling(*child)) {
+    if (!child->NeedsStyleRecalc() && !child->ChildNeedsStyleRecalc())
+      continue;
+    stats.recalc_subtrees++;
+    if (!siblings_dependent)
+      stats.independent_recalc_subtrees++;
+  }
+}
+
 void StyleEngine::RecalcStyle() {
   DCHECK(GetDocument().documentElement());
   Element* root_element = &style_recalc_root_.RootElement();
   Element* parent = root_element->ParentOrShadowHostElement();
 
+  if (Stats())
+    CountRecalcSubtrees(*root_element, *Stats());
+
   SelectorFilterRootScope filter_scope(parent);
   root_element->RecalcStyle({});
 
@@ -2044,6 +2118,7 @@ void StyleEngine::Trace(blink::Visitor* visitor) {
   visitor->Trace(viewport_resolver_);
   visitor->Trace(media_query_evaluator_);
   visitor->Trace(global_rule_set_);
+  visitor->Trace(invalidation_set_profiler_);
   visitor->Trace(pending_invalidations_);
   visitor->Trace(style_invalidation_root_);
   visitor->Trace(style_recalc_root_);
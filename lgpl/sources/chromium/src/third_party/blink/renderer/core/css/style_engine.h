@@ -39,6 +39,7 @@
 #include "third_party/blink/renderer/core/css/active_style_sheets.h"
 #include "third_party/blink/renderer/core/css/css_global_rule_set.h"
 #include "third_party/blink/renderer/core/css/document_style_sheet_collection.h"
+#include "third_party/blink/renderer/core/css/invalidation/invalidation_set_profiler.h"
 #include "third_party/blink/renderer/core/css/invalidation/pending_invalidations.h"
 #include "third_party/blink/renderer/core/css/invalidation/style_invalidator.h"
 #include "third_party/blink/renderer/core/css/layout_tree_rebuild_root.h"
@@ -313,6 +314,12 @@ class CORE_EXPORT StyleEngine final : public GarbageCollected<StyleEngine>,
   StyleResolverStats* Stats() { return style_resolver_stats_.get(); }
   void SetStatsEnabled(bool);
 
+  InvalidationSetProfiler* GetInvalidationSetProfiler() {
+    return invalidation_set_profiler_;
+  }
+  // Keeps the accumulated profile while enabled; disabling drops it.
+  void SetInvalidationSetProfilingEnabled(bool);
+
   void ApplyRuleSetChanges(TreeScope&,
                            const ActiveStyleSheetVector& old_style_sheets,
                            const ActiveStyleSheetVector& new_style_sheets);
@@ -550,6 +557,8 @@ class CORE_EXPORT StyleEngine final : public GarbageCollected<StyleEngine>,
   std::unique_ptr<StyleResolverStats> style_resolver_stats_;
   unsigned style_for_element_count_ = 0;
 
+  Member<InvalidationSetProfiler> invalidation_set_profiler_;
+
   HeapVector<std::pair<StyleSheetKey, Member<CSSStyleSheet>>>
       injected_user_style_sheets_;
   HeapVector<std::pair<StyleSheetKey, Member<CSSStyleSheet>>>
@@ -40,6 +40,7 @@
 #include "third_party/blink/renderer/platform/geometry/float_size.h"
 #include "third_party/blink/renderer/platform/heap/heap.h"
 #include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
 
 namespace blink {
 
@@ -73,6 +74,11 @@ class StyleEngineTest : public testing::Test {
     return GetStyleEngine().style_recalc_root_.GetRootNode();
   }
 
+  void UpdateActiveStyleSheets() { GetStyleEngine().UpdateActiveStyleSheets(); }
+  bool IsGlobalRuleSetDirty() {
+    return GetStyleEngine().global_rule_set_->IsDirty();
+  }
+
  private:
   std::unique_ptr<DummyPageHolder> dummy_page_holder_;
 };
@@ -914,6 +920,45 @@ TEST_F(StyleEngineTest, HasViewportDependentMediaQueries) {
   EXPECT_FALSE(GetStyleEngine().HasViewportDependentMediaQueries());
 }
 
+TEST_F(StyleEngineTest, IncrementalRuleFeatureSet) {
+  ScopedIncrementalRuleFeatureSetForTest scoped_feature(true);
+
+  GetDocument().body()->SetInnerHTMLFromString(R"HTML(
+    <style>#first { color: green }</style>
+    <style id='sheet'>#second { color: green }</style>
+  )HTML");
+  UpdateAllLifecyclePhases();
+  EXPECT_TRUE(GetStyleEngine().HasRulesForId("first"));
+  EXPECT_TRUE(GetStyleEngine().HasRulesForId("second"));
+
+  // The features of a removed sheet are kept until the next full update.
+  Element* style_element = GetDocument().getElementById("sheet");
+  GetDocument().body()->RemoveChild(style_element);
+  UpdateActiveStyleSheets();
+  EXPECT_FALSE(IsGlobalRuleSetDirty());
+  EXPECT_TRUE(GetStyleEngine().HasRulesForId("second"));
+
+  auto* appended = MakeGarbageCollected<HTMLStyleElement>(GetDocument(),
+                                                          CreateElementFlags());
+  appended->setTextContent("#third { color: green }");
+  GetDocument().body()->AppendChild(appended);
+  UpdateActiveStyleSheets();
+  EXPECT_FALSE(IsGlobalRuleSetDirty());
+  EXPECT_TRUE(GetStyleEngine().HasRulesForId("first"));
+  EXPECT_TRUE(GetStyleEngine().HasRulesForId("third"));
+  EXPECT_FALSE(GetStyleEngine().HasRulesForId("fourth"));
+
+  // Modifying a sheet requires a full update.
+  appended->setTextContent("#fourth { color: green }");
+  UpdateActiveStyleSheets();
+  EXPECT_TRUE(IsGlobalRuleSetDirty());
+  UpdateAllLifecyclePhases();
+  EXPECT_TRUE(GetStyleEngine().HasRulesForId("first"));
+  EXPECT_FALSE(GetStyleEngine().HasRulesForId("second"));
+  EXPECT_FALSE(GetStyleEngine().HasRulesForId("third"));
+  EXPECT_TRUE(GetStyleEngine().HasRulesForId("fourth"));
+}
+
 TEST_F(StyleEngineTest, StyleMediaAttributeStyleChange) {
   GetDocument().body()->SetInnerHTMLFromString(
       "<style id='s1' media='(max-width: 1px)'>#t1 { color: green }</style>"
@@ -1827,6 +1872,108 @@ TEST_F(StyleEngineTest, RejectSelectorForPseudoElement) {
   EXPECT_EQ(2u, stats->rules_fast_rejected);
 }
 
+TEST_F(StyleEngineTest, AdaptiveSelectorFilterWidensOnDeepTree) {
+  ScopedAdaptiveSelectorFilterForTest scoped_feature(true);
+
+  StringBuilder builder;
+  builder.Append("<style>.not-in-filter span { color: red }</style>");
+  // 100 ancestors with four unique classes each exceed what the default
+  // 2^12 slot ancestor filter can hold with a low false positive rate.
+  for (unsigned i = 0; i < 100; i++) {
+    builder.Append("<div class='a");
+    builder.AppendNumber(i);
+    builder.Append(" b");
+    builder.AppendNumber(i);
+    builder.Append(" c");
+    builder.AppendNumber(i);
+    builder.Append(" d");
+    builder.AppendNumber(i);
+    builder.Append("'>");
+  }
+  builder.Append("<span></span>");
+
+  // Enable stats before the first recalc, which starts with the narrow filter
+  // and has to widen it part way down the tree.
+  StyleEngine& engine = GetStyleEngine();
+  engine.SetStatsEnabled(true);
+  StyleResolverStats* stats = engine.Stats();
+  ASSERT_TRUE(stats);
+
+  GetDocument().body()->SetInnerHTMLFromString(builder.ToString());
+  UpdateAllLifecyclePhases();
+
+  EXPECT_EQ(1u, stats->selector_filter_widened);
+  EXPECT_GT(stats->selector_filter_peak_identifiers, 400u);
+  EXPECT_GT(stats->selector_filter_false_positive_rate, 0);
+  EXPECT_LT(stats->selector_filter_false_positive_rate, 0.01);
+  EXPECT_GE(stats->rules_fast_rejected, 1u);
+
+  // The peak of the previous recalc makes the next one start with the wide
+  // filter, so no widening happens mid-recalc.
+  engine.SetStatsEnabled(true);
+  GetDocument().documentElement()->SetInlineStyleProperty(
+      CSSPropertyID::kFontSize, "20px");
+  GetDocument().Lifecycle().AdvanceTo(DocumentLifecycle::kInStyleRecalc);
+  GetStyleEngine().RecalcStyle();
+
+  EXPECT_EQ(0u, stats->selector_filter_widened);
+  EXPECT_GT(stats->selector_filter_peak_identifiers, 400u);
+  EXPECT_GT(stats->selector_filter_false_positive_rate, 0);
+  EXPECT_LT(stats->selector_filter_false_positive_rate, 0.01);
+  EXPECT_GE(stats->rules_fast_rejected, 1u);
+}
+
+TEST_F(StyleEngineTest, RecalcSubtreeStats) {
+  GetDocument().body()->SetInnerHTMLFromString(R"HTML(
+    <div id=root>
+      <span></span>
+      <span></span>
+      <span></span>
+    </div>
+    <div id=adjacent>
+      <style>.x + span { color: green }</style>
+      <span class=x></span>
+      <span></span>
+    </div>
+  )HTML");
+  UpdateAllLifecyclePhases();
+
+  StyleEngine& engine = GetStyleEngine();
+  engine.SetStatsEnabled(true);
+  StyleResolverStats* stats = engine.Stats();
+  ASSERT_TRUE(stats);
+
+  HTMLCollection* spans =
+      GetDocument().getElementById("root")->getElementsByTagName("span");
+  ASSERT_EQ(3u, spans->length());
+  spans->item(0)->SetInlineStyleProperty(CSSPropertyID::kColor, "green");
+  spans->item(2)->SetInlineStyleProperty(CSSPropertyID::kColor, "green");
+
+  GetDocument().Lifecycle().AdvanceTo(DocumentLifecycle::kInStyleRecalc);
+  GetStyleEngine().RecalcStyle();
+  GetDocument().Lifecycle().AdvanceTo(DocumentLifecycle::kStyleClean);
+
+  EXPECT_EQ(2u, stats->recalc_subtrees);
+  EXPECT_EQ(2u, stats->independent_recalc_subtrees);
+
+  UpdateAllLifecyclePhases();
+  engine.SetStatsEnabled(true);
+  stats = engine.Stats();
+  ASSERT_TRUE(stats);
+
+  spans = GetDocument().getElementById("adjacent")->getElementsByTagName(
+      "span");
+  ASSERT_EQ(2u, spans->length());
+  spans->item(0)->SetInlineStyleProperty(CSSPropertyID::kColor, "red");
+  spans->item(1)->SetInlineStyleProperty(CSSPropertyID::kColor, "red");
+
+  GetDocument().Lifecycle().AdvanceTo(DocumentLifecycle::kInStyleRecalc);
+  GetStyleEngine().RecalcStyle();
+
+  EXPECT_EQ(2u, stats->recalc_subtrees);
+  EXPECT_EQ(0u, stats->independent_recalc_subtrees);
+}
+
 TEST_F(StyleEngineTest, MarkForWhitespaceReattachment) {
   GetDocument().body()->SetInnerHTMLFromString(R"HTML(
     <div id=d1><span></span></div>
@@ -27,6 +27,7 @@
 #include "third_party/blink/renderer/core/css/style_rule.h"
 #include "third_party/blink/renderer/core/css/style_rule_import.h"
 #include "third_party/blink/renderer/core/css/style_rule_namespace.h"
+#include "third_party/blink/renderer/core/css/style_sheet_contents_cache.h"
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/dom/node.h"
 #include "third_party/blink/renderer/core/inspector/inspector_trace_events.h"
@@ -34,6 +35,7 @@
 #include "third_party/blink/renderer/platform/heap/heap.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
 #include "third_party/blink/renderer/platform/instrumentation/use_counter.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 #include "third_party/blink/renderer/platform/weborigin/security_origin.h"
 
 namespace blink {
@@ -344,10 +346,48 @@ void StyleSheetContents::ParseAuthorStyleSheet(
     source_map_url_ = response.HttpHeaderField(http_names::kXSourceMap);
   }
 
+  StyleSheetContentsCache* contents_cache = nullptr;
+  if (RuntimeEnabledFeatures::StyleSheetContentsCacheEnabled() &&
+      !owner_rule_) {
+    contents_cache = &StyleSheetContentsCache::Instance();
+    if (StyleSheetContents* cached_contents =
+            contents_cache->Find(sheet_text, *parser_context_)) {
+      AdoptRulesFrom(*cached_contents);
+      return;
+    }
+  }
+
   const auto* context =
       MakeGarbageCollected<CSSParserContext>(ParserContext(), this);
   CSSParser::ParseSheet(context, this, sheet_text,
-                        CSSDeferPropertyParsing::kYes);
+                        CSSDeferPropertyParsing::kYes,
+                        true /* allow_import_rules */,
+                        cached_style_sheet->BlockSkipIndexFor(sheet_text));
+
+  if (contents_cache && StyleSheetContentsCache::IsCacheable(*this))
+    contents_cache->Add(sheet_text, this);
+}
+
+void StyleSheetContents::AdoptRulesFrom(StyleSheetContents& source) {
+  DCHECK(import_rules_.IsEmpty());
+  DCHECK(namespace_rules_.IsEmpty());
+  DCHECK(child_rules_.IsEmpty());
+  DCHECK(source.import_rules_.IsEmpty());
+
+  rules_source_ = &source;
+  namespace_rules_ = source.namespace_rules_;
+  child_rules_ = source.child_rules_;
+  namespaces_ = source.namespaces_;
+  default_namespace_ = source.default_namespace_;
+  has_syntactically_valid_css_header_ =
+      source.has_syntactically_valid_css_header_;
+  has_font_face_rule_ = source.has_font_face_rule_;
+  has_viewport_rule_ = source.has_viewport_rule_;
+  has_media_queries_ = source.has_media_queries_;
+
+  // The rules are shared with |source|, so they must be copied before
+  // mutation.
+  SetIsUsedFromTextCache();
 }
 
 ParseSheetResult StyleSheetContents::ParseString(const String& sheet_text,
@@ -684,6 +724,7 @@ void StyleSheetContents::Trace(blink::Visitor* visitor) {
   visitor->Trace(rule_set_);
   visitor->Trace(referenced_from_resource_);
   visitor->Trace(parser_context_);
+  visitor->Trace(rules_source_);
 }
 
 }  // namespace blink
@@ -198,6 +198,10 @@ class CORE_EXPORT StyleSheetContents final
   Document* ClientSingleOwnerDocument() const;
   Document* ClientAnyOwnerDocument() const;
 
+  // Shares the already parsed rules of |source| instead of parsing the same
+  // sheet text again. See StyleSheetContentsCache.
+  void AdoptRulesFrom(StyleSheetContents& source);
+
   Member<StyleRuleImport> owner_rule_;
 
   String original_url_;
@@ -226,6 +230,10 @@ class CORE_EXPORT StyleSheetContents final
 
   Member<RuleSet> rule_set_;
   String source_map_url_;
+
+  // The contents whose rules were adopted, if any. Deferred property parsing
+  // of the shared rules refers to these contents, so they are kept alive.
+  Member<StyleSheetContents> rules_source_;
 };
 
 }  // namespace blink
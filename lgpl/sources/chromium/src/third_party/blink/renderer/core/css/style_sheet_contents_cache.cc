@@ -0,0 +1,112 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/css/style_sheet_contents_cache.h"
+
+#include "third_party/blink/renderer/core/css/parser/css_parser_context.h"
+#include "third_party/blink/renderer/core/css/style_sheet_contents.h"
+#include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
+#include "third_party/blink/renderer/platform/wtf/wtf.h"
+
+namespace blink {
+
+StyleSheetContentsCache& StyleSheetContentsCache::Instance() {
+  DCHECK(IsMainThread());
+  DEFINE_STATIC_LOCAL(Persistent<StyleSheetContentsCache>, cache,
+                      (MakeGarbageCollected<StyleSheetContentsCache>()));
+  return *cache;
+}
+
+StyleSheetContents* StyleSheetContentsCache::Find(
+    const String& text,
+    const CSSParserContext& context) {
+  if (text.IsEmpty())
+    return nullptr;
+  auto it = cache_.find(text);
+  if (it == cache_.end()) {
+    RecordMiss();
+    return nullptr;
+  }
+  StyleSheetContents* contents = it->value;
+  const CSSParserContext& cached_context = *contents->ParserContext();
+  bool context_matches = IsBaseURLIndependent(text)
+                             ? cached_context.EqualsIgnoringBaseURL(context)
+                             : cached_context == context;
+  if (!context_matches || !IsCacheable(*contents)) {
+    RecordMiss();
+    return nullptr;
+  }
+  RecordHit();
+  return contents;
+}
+
+void StyleSheetContentsCache::Add(const String& text,
+                                  StyleSheetContents* contents) {
+  DCHECK(contents);
+  DCHECK(IsCacheable(*contents));
+  if (text.IsEmpty() || text.length() > kMaxTotalTextLength)
+    return;
+
+  contents->SetIsUsedFromTextCache();
+  auto result = cache_.Set(text, contents);
+  if (!result.is_new_entry)
+    return;
+
+  insertion_order_.push_back(text);
+  total_text_length_ += text.length();
+  while (total_text_length_ > kMaxTotalTextLength) {
+    const String& oldest = insertion_order_.front();
+    total_text_length_ -= oldest.length();
+    cache_.erase(oldest);
+    insertion_order_.pop_front();
+  }
+}
+
+void StyleSheetContentsCache::Clear() {
+  cache_.clear();
+  insertion_order_.clear();
+  total_text_length_ = 0;
+  hit_count_ = 0;
+  miss_count_ = 0;
+}
+
+bool StyleSheetContentsCache::IsCacheable(const StyleSheetContents& contents) {
+  // Import rules would require tracking the loads of the child sheets for
+  // every document sharing the rules.
+  if (contents.OwnerRule() || !contents.IsCacheableForStyleElement())
+    return false;
+  if (contents.IsCacheableForResource() &&
+      contents.HasFailedOrCanceledSubresources()) {
+    return false;
+  }
+  return true;
+}
+
+bool StyleSheetContentsCache::IsBaseURLIndependent(const String& text) {
+  // Escapes may spell out any of the functions below.
+  if (text.find('\\') != kNotFound)
+    return false;
+  return text.FindIgnoringASCIICase("url(") == kNotFound &&
+         text.FindIgnoringASCIICase("image(") == kNotFound &&
+         text.FindIgnoringASCIICase("image-set(") == kNotFound &&
+         text.FindIgnoringASCIICase("@import") == kNotFound;
+}
+
+void StyleSheetContentsCache::RecordHit() {
+  ++hit_count_;
+  TRACE_COUNTER1("blink,blink_style", "StyleSheetContentsCache::hits",
+                 hit_count_);
+}
+
+void StyleSheetContentsCache::RecordMiss() {
+  ++miss_count_;
+  TRACE_COUNTER1("blink,blink_style", "StyleSheetContentsCache::misses",
+                 miss_count_);
+}
+
+void StyleSheetContentsCache::Trace(blink::Visitor* visitor) {
+  visitor->Trace(cache_);
+}
+
+}  // namespace blink
@@ -0,0 +1,72 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef THIRD_PARTY_BLINK_RENDERER_CORE_CSS_STYLE_SHEET_CONTENTS_CACHE_H_
+#define THIRD_PARTY_BLINK_RENDERER_CORE_CSS_STYLE_SHEET_CONTENTS_CACHE_H_
+
+#include "base/macros.h"
+#include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/platform/heap/handle.h"
+#include "third_party/blink/renderer/platform/wtf/deque.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_hash.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
+
+namespace blink {
+
+class CSSParserContext;
+class StyleSheetContents;
+
+// Process wide cache of parsed author style sheets, keyed by the content hash
+// of the sheet text. Frames and pages loading byte-identical style sheets
+// share the parsed rules instead of running the CSS parser again.
+//
+// Cached contents are immutable: both the cached contents and any contents
+// adopting rules from it are marked as used from a text cache, so CSSOM
+// mutations copy the rules first (see CSSStyleSheet::WillMutateRules).
+class CORE_EXPORT StyleSheetContentsCache final
+    : public GarbageCollected<StyleSheetContentsCache> {
+ public:
+  static StyleSheetContentsCache& Instance();
+
+  StyleSheetContentsCache() = default;
+
+  // Returns cached contents for |text| that were parsed with a context
+  // compatible with |context|, or nullptr.
+  StyleSheetContents* Find(const String& text, const CSSParserContext&);
+  void Add(const String& text, StyleSheetContents*);
+  void Clear();
+
+  wtf_size_t size() const { return cache_.size(); }
+  size_t TotalTextLength() const { return total_text_length_; }
+  unsigned HitCount() const { return hit_count_; }
+  unsigned MissCount() const { return miss_count_; }
+
+  static bool IsCacheable(const StyleSheetContents&);
+
+  // Sheets whose text cannot resolve against the base URL may be shared
+  // between different URLs.
+  static bool IsBaseURLIndependent(const String& text);
+
+  // The oldest entries are evicted once the total length of the cached sheet
+  // texts exceeds this.
+  static constexpr size_t kMaxTotalTextLength = 16 * 1024 * 1024;
+
+  void Trace(blink::Visitor*);
+
+ private:
+  void RecordHit();
+  void RecordMiss();
+
+  HeapHashMap<String, Member<StyleSheetContents>> cache_;
+  // Keys of |cache_| in insertion order.
+  Deque<String> insertion_order_;
+  size_t total_text_length_ = 0;
+  unsigned hit_count_ = 0;
+  unsigned miss_count_ = 0;
+  DISALLOW_COPY_AND_ASSIGN(StyleSheetContentsCache);
+};
+
+}  // namespace blink
+
+#endif  // THIRD_PARTY_BLINK_RENDERER_CORE_CSS_STYLE_SHEET_CONTENTS_CACHE_H_
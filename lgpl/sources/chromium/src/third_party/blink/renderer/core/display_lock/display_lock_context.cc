@@ -18,6 +18,7 @@
 #include "third_party/blink/renderer/core/dom/dom_exception.h"
 #include "third_party/blink/renderer/core/dom/element.h"
 #include "third_party/blink/renderer/core/dom/node_computed_style.h"
+#include "third_party/blink/renderer/core/dom/space_split_string.h"
 #include "third_party/blink/renderer/core/frame/local_frame_view.h"
 #include "third_party/blink/renderer/core/inspector/inspector_trace_events.h"
 #include "third_party/blink/renderer/core/layout/layout_box.h"
@@ -27,6 +28,7 @@
 #include "third_party/blink/renderer/core/paint/pre_paint_tree_walk.h"
 #include "third_party/blink/renderer/platform/bindings/microtask.h"
 #include "third_party/blink/renderer/platform/heap/heap.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
 
 namespace blink {
 
@@ -110,6 +112,11 @@ void DisplayLockContext::Dispose() {
 void DisplayLockContext::ContextDestroyed(ExecutionContext*) {
   FinishUpdateResolver(kReject, rejection_names::kExecutionContextDestroyed);
   state_ = kUnlocked;
+  if (is_auto_observed_) {
+    if (document_)
+      document_->UnregisterDisplayLockAutoObservation(element_);
+    is_auto_observed_ = false;
+  }
 }
 
 void DisplayLockContext::UpdateActivationObservationIfNeeded() {
@@ -118,7 +125,9 @@ void DisplayLockContext::UpdateActivationObservationIfNeeded() {
     return;
   }
 
-  bool should_observe = IsLocked() &&
+  // Auto locks are committed by the auto observation instead, which starts
+  // before the element reaches the viewport.
+  bool should_observe = IsLocked() && !is_auto_ &&
                         IsActivatable(DisplayLockActivationReason::kViewport) &&
                         ConnectedToView();
   if (should_observe && !is_observed_) {
@@ -129,6 +138,23 @@ void DisplayLockContext::UpdateActivationObservationIfNeeded() {
   is_observed_ = should_observe;
 }
 
+void DisplayLockContext::UpdateAutoObservationIfNeeded() {
+  if (!document_) {
+    is_auto_observed_ = false;
+    return;
+  }
+
+  // Unlike the activation observation, this doesn't depend on the lock state,
+  // since we also need to know when an unlocked element leaves the viewport.
+  bool should_observe = is_auto_ && ConnectedToView();
+  if (should_observe && !is_auto_observed_) {
+    document_->RegisterDisplayLockAutoObservation(element_);
+  } else if (!should_observe && is_auto_observed_) {
+    document_->UnregisterDisplayLockAutoObservation(element_);
+  }
+  is_auto_observed_ = should_observe;
+}
+
 void DisplayLockContext::SetActivatable(unsigned char activatable_mask) {
   if (IsLocked()) {
     // If we're locked, the activatable mask might change the activation
@@ -142,6 +168,64 @@ void DisplayLockContext::SetActivatable(unsigned char activatable_mask) {
   UpdateActivationObservationIfNeeded();
 }
 
+void DisplayLockContext::SetIsAuto(bool is_auto) {
+  if (is_auto_ == is_auto)
+    return;
+  is_auto_ = is_auto;
+  if (!is_auto_)
+    locked_content_logical_size_.reset();
+  UpdateActivationObservationIfNeeded();
+  UpdateAutoObservationIfNeeded();
+}
+
+namespace {
+
+// Returns the value of the rendersubtree attribute with the "invisible" token
+// added or removed, keeping all other tokens.
+AtomicString RenderSubtreeValueWithInvisible(const AtomicString& value,
+                                             bool invisible) {
+  SpaceSplitString tokens(value.LowerASCII());
+  StringBuilder builder;
+  if (invisible)
+    builder.Append("invisible");
+  for (wtf_size_t i = 0; i < tokens.size(); ++i) {
+    if (tokens[i] == "invisible")
+      continue;
+    if (!builder.IsEmpty())
+      builder.Append(' ');
+    builder.Append(tokens[i]);
+  }
+  return builder.ToAtomicString();
+}
+
+}  // namespace
+
+void DisplayLockContext::NotifyIsNearViewport(bool is_near_viewport) {
+  if (!is_auto_ || !element_ || !ConnectedToView())
+    return;
+
+  if (is_near_viewport == !IsLocked())
+    return;
+
+  if (is_near_viewport) {
+    locked_content_logical_size_.reset();
+  } else if (auto* layout_box = element_->GetLayoutBox()) {
+    // Remember the size that the contents had, so that the element doesn't
+    // change size when it gets locked, and the page doesn't jump around as
+    // elements are locked and committed while scrolling.
+    locked_content_logical_size_.emplace(layout_box->ContentLogicalWidth(),
+                                         layout_box->ContentLogicalHeight());
+  }
+
+  // Go through the attribute, so that it reflects the state of the lock. The
+  // attribute change acquires or commits the lock.
+  const AtomicString& value =
+      element_->FastGetAttribute(html_names::kRendersubtreeAttr);
+  element_->setAttribute(
+      html_names::kRendersubtreeAttr,
+      RenderSubtreeValueWithInvisible(value, !is_near_viewport));
+}
+
 void DisplayLockContext::StartAcquire() {
   DCHECK(!IsLocked());
   update_budget_.reset();
@@ -395,8 +479,17 @@ void DisplayLockContext::CommitForActivationWithSignal(
   StartCommit();
   // Since setting the attribute might trigger a commit if we are still locked,
   // we set it after we start the commit.
-  if (element_->hasAttribute(html_names::kRendersubtreeAttr))
-    element_->setAttribute(html_names::kRendersubtreeAttr, "");
+  if (element_->hasAttribute(html_names::kRendersubtreeAttr)) {
+    // Auto locks keep their other tokens, so that they can lock again when
+    // the element moves away from the viewport.
+    element_->setAttribute(
+        html_names::kRendersubtreeAttr,
+        is_auto_ ? RenderSubtreeValueWithInvisible(
+                       element_->FastGetAttribute(
+                           html_names::kRendersubtreeAttr),
+                       false)
+                 : g_empty_atom);
+  }
 }
 
 bool DisplayLockContext::ShouldCommitForActivation(
@@ -657,6 +750,10 @@ void DisplayLockContext::DidMoveToNewDocument(Document& old_document) {
     old_document.UnregisterDisplayLockActivationObservation(element_);
     document_->RegisterDisplayLockActivationObservation(element_);
   }
+  if (is_auto_observed_) {
+    old_document.UnregisterDisplayLockAutoObservation(element_);
+    document_->RegisterDisplayLockAutoObservation(element_);
+  }
 
   // Since we're observing the lifecycle updates, ensure that we listen to the
   // right document's view.
@@ -735,10 +832,12 @@ void DisplayLockContext::NotifyWillDisconnect() {
 
 void DisplayLockContext::ElementDisconnected() {
   UpdateActivationObservationIfNeeded();
+  UpdateAutoObservationIfNeeded();
 }
 
 void DisplayLockContext::ElementConnected() {
   UpdateActivationObservationIfNeeded();
+  UpdateAutoObservationIfNeeded();
 }
 
 void DisplayLockContext::ScheduleAnimation() {
@@ -5,12 +5,14 @@
 #ifndef THIRD_PARTY_BLINK_RENDERER_CORE_DISPLAY_LOCK_DISPLAY_LOCK_CONTEXT_H_
 #define THIRD_PARTY_BLINK_RENDERER_CORE_DISPLAY_LOCK_DISPLAY_LOCK_CONTEXT_H_
 
+#include "base/optional.h"
 #include "third_party/blink/renderer/bindings/core/v8/active_script_wrappable.h"
 #include "third_party/blink/renderer/bindings/core/v8/script_promise_resolver.h"
 #include "third_party/blink/renderer/core/core_export.h"
 #include "third_party/blink/renderer/core/display_lock/display_lock_budget.h"
 #include "third_party/blink/renderer/core/frame/local_frame_view.h"
 #include "third_party/blink/renderer/platform/bindings/script_wrappable.h"
+#include "third_party/blink/renderer/platform/geometry/layout_size.h"
 #include "third_party/blink/renderer/platform/scheduler/public/post_cancellable_task.h"
 #include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
 
@@ -115,6 +117,23 @@ class CORE_EXPORT DisplayLockContext final
   // Set which reasons activate, as a mask of DisplayLockActivationReason enums.
   void SetActivatable(unsigned char activatable_mask);
 
+  // Auto locks are locked while the element is far from the viewport, and
+  // committed when it gets near to it. When an auto lock is re-acquired, the
+  // element keeps the content size it had, see LockedContentLogicalSize().
+  void SetIsAuto(bool is_auto);
+  bool IsAuto() const { return is_auto_; }
+
+  // Called for auto locks when the element moves near to, or away from, the
+  // viewport.
+  void NotifyIsNearViewport(bool is_near_viewport);
+
+  // The content size of the element when an auto lock was last acquired, if
+  // it had been laid out. While locked, this is used as the content size
+  // under size containment instead of content-size.
+  const base::Optional<LayoutSize>& LockedContentLogicalSize() const {
+    return locked_content_logical_size_;
+  }
+
   // Acquire the lock, should only be called when unlocked.
   void StartAcquire();
   // Initiate a commit.
@@ -308,6 +327,9 @@ class CORE_EXPORT DisplayLockContext final
   // register/unregister is required.
   void UpdateActivationObservationIfNeeded();
 
+  // Same as above, for the observation of auto locks.
+  void UpdateAutoObservationIfNeeded();
+
   std::unique_ptr<DisplayLockBudget> update_budget_;
 
   Member<ScriptPromiseResolver> update_resolver_;
@@ -347,6 +369,10 @@ class CORE_EXPORT DisplayLockContext final
   // document level intersection observer.
   bool is_observed_ = false;
 
+  bool is_auto_ = false;
+  bool is_auto_observed_ = false;
+  base::Optional<LayoutSize> locked_content_logical_size_;
+
   unsigned char activatable_mask_ =
       static_cast<unsigned char>(DisplayLockActivationReason::kAny);
 };
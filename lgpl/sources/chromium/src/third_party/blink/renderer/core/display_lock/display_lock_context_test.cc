@@ -1485,6 +1485,57 @@ TEST_F(DisplayLockContextTest, DisconnectedWhileUpdating) {
   test::RunPendingTasks();
 }
 
+TEST_F(DisplayLockContextTest, AutoLockKeepsContentSize) {
+  ResizeAndFocus();
+  SetHtmlInnerHTML(R"HTML(
+    <style>
+    #target {
+      width: 100px;
+    }
+    #child {
+      height: 200px;
+    }
+    </style>
+    <div id="target" rendersubtree="auto skip-viewport-activation">
+      <div id="child"></div>
+    </div>
+  )HTML");
+
+  auto* target = GetDocument().getElementById("target");
+  auto* context = target->GetDisplayLockContext();
+  ASSERT_TRUE(context);
+  EXPECT_TRUE(context->IsAuto());
+  EXPECT_FALSE(context->IsLocked());
+
+  // Moving away from the viewport locks the element, and remembers the size
+  // of its contents.
+  context->NotifyIsNearViewport(false);
+  EXPECT_TRUE(context->IsLocked());
+  EXPECT_EQ("invisible auto skip-viewport-activation",
+            target->getAttribute(html_names::kRendersubtreeAttr));
+  ASSERT_TRUE(context->LockedContentLogicalSize());
+  EXPECT_EQ(LayoutSize(100, 200), *context->LockedContentLogicalSize());
+
+  // Size containment uses the remembered size instead of an empty one.
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_EQ(LayoutUnit(200), target->GetLayoutBox()->LogicalHeight());
+
+  // Moving near the viewport commits the element, and keeps the other tokens.
+  context->NotifyIsNearViewport(true);
+  EXPECT_FALSE(context->IsLocked());
+  EXPECT_EQ("auto skip-viewport-activation",
+            target->getAttribute(html_names::kRendersubtreeAttr));
+  EXPECT_FALSE(context->LockedContentLogicalSize());
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_EQ(LayoutUnit(200), target->GetLayoutBox()->LogicalHeight());
+
+  // Removing the token stops the element from locking.
+  target->setAttribute(html_names::kRendersubtreeAttr, "");
+  EXPECT_FALSE(context->IsAuto());
+  context->NotifyIsNearViewport(false);
+  EXPECT_FALSE(context->IsLocked());
+}
+
 class DisplayLockContextRenderingTest : public RenderingTest,
                                         private ScopedDisplayLockingForTest {
  public:
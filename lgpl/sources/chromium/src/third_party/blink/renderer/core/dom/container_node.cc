@@ -899,6 +899,51 @@ void ContainerNode::ParserAppendChild(Node* new_child) {
   NotifyNodeInserted(*new_child, kChildrenChangeSourceParser);
 }
 
+void ContainerNode::ParserAppendChildren(const NodeVector& children) {
+  DCHECK(!IsHTMLTemplateElement(this));
+  DCHECK(!IsDocumentNode());
+
+  RUNTIME_CALL_TIMER_SCOPE(V8PerIsolateData::MainThreadIsolate(),
+                           RuntimeCallStats::CounterId::kParserAppendChild);
+
+  if (children.IsEmpty())
+    return;
+#if DCHECK_IS_ON()
+  // The same invariants as ParserAppendChild(), which removes the child from
+  // its parent and adopts it instead.
+  for (const auto& child : children) {
+    DCHECK(child);
+    DCHECK(!child->IsDocumentFragment());
+    DCHECK(!child->parentNode());
+    DCHECK_EQ(GetDocument(), child->GetDocument());
+  }
+#endif
+
+  Node* unchanged_previous = lastChild();
+  NodeVector post_insertion_notification_targets;
+  InsertNodeVector(children, nullptr, AdoptAndAppendChild(),
+                   &post_insertion_notification_targets);
+#if DCHECK_IS_ON()
+  for (const auto& child : children)
+    DCHECK_EQ(child->ConnectedSubframeCount(), 0u);
+#endif
+
+  // Done once here instead of in ChildrenChanged() for every child; see
+  // ChildrenChange::in_parser_batch.
+  GetDocument().IncDOMTreeVersion();
+  GetDocument().NotifyChangeChildren(*this);
+  InvalidateNodeListCachesInAncestors(nullptr, nullptr, nullptr);
+  for (const auto& child : children) {
+    ChildrenChanged(
+        ChildrenChange::ForParserBatchInsertion(*child, unchanged_previous));
+  }
+
+  for (const auto& target_node : post_insertion_notification_targets) {
+    if (target_node->isConnected())
+      target_node->DidNotifySubtreeInsertionsToDocument();
+  }
+}
+
 DISABLE_CFI_PERF
 void ContainerNode::NotifyNodeInserted(Node& root,
                                        ChildrenChangeSource source) {
@@ -1004,9 +1049,11 @@ void ContainerNode::DetachLayoutTree(bool performing_reattach) {
 }
 
 void ContainerNode::ChildrenChanged(const ChildrenChange& change) {
-  GetDocument().IncDOMTreeVersion();
-  GetDocument().NotifyChangeChildren(*this);
-  InvalidateNodeListCachesInAncestors(nullptr, nullptr, &change);
+  if (!change.in_parser_batch) {
+    GetDocument().IncDOMTreeVersion();
+    GetDocument().NotifyChangeChildren(*this);
+    InvalidateNodeListCachesInAncestors(nullptr, nullptr, &change);
+  }
 
   if (change.IsChildRemoval() || change.type == kAllChildrenRemoved) {
     GetDocument().GetStyleEngine().ChildrenRemoved(*this);
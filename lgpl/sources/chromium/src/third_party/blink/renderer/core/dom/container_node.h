@@ -139,6 +139,10 @@ class CORE_EXPORT ContainerNode : public Node {
   // These methods are only used during parsing.
   // They don't send DOM mutation events or accept DocumentFragments.
   void ParserAppendChild(Node*);
+  // Appends |children|, which have no parent yet, in order. Equivalent to
+  // ParserAppendChild() for each of them, except that the DOM tree version
+  // and node list caches are updated once for the whole batch.
+  void ParserAppendChildren(const NodeVector& children);
   void ParserRemoveChild(Node&);
   void ParserInsertBefore(Node* new_child, Node& ref_child);
   void ParserTakeAllChildrenFrom(ContainerNode&);
@@ -322,6 +326,15 @@ class CORE_EXPORT ContainerNode : public Node {
       return change;
     }
 
+    // For each child appended by ParserAppendChildren().
+    static ChildrenChange ForParserBatchInsertion(Node& node,
+                                                  Node* unchanged_previous) {
+      ChildrenChange change = ForInsertion(node, unchanged_previous, nullptr,
+                                           kChildrenChangeSourceParser);
+      change.in_parser_batch = true;
+      return change;
+    }
+
     static ChildrenChange ForRemoval(Node& node,
                                      Node* previous_sibling,
                                      Node* next_sibling,
@@ -356,6 +369,9 @@ class CORE_EXPORT ContainerNode : public Node {
     //  - nextSibling of the last inserted node after multiple node insertion.
     Member<Node> sibling_after_change;
     ChildrenChangeSource by_parser;
+    // Whether the DOM tree version and node list caches have already been
+    // updated for a batch of insertions that includes this one.
+    bool in_parser_batch = false;
   };
 
   // Notifies the node that it's list of children have changed (either by adding
@@ -2438,6 +2438,8 @@ void Document::UpdateStyleInvalidationIfNeeded() {
   DCHECK(IsActive());
   ScriptForbiddenScope forbid_script;
 
+  GetStyleEngine().SetInvalidationSetProfilingEnabled(
+      InvalidationSetProfiler::IsEnabled());
   if (!GetStyleEngine().NeedsStyleInvalidation())
     return;
   TRACE_EVENT0("blink", "Document::updateStyleInvalidationIfNeeded");
@@ -2844,6 +2846,10 @@ void Document::UpdateStyle() {
   GetStyleEngine().SetStatsEnabled(should_record_stats);
 
   GetStyleEngine().UpdateStyleAndLayoutTree();
+  if (InvalidationSetProfiler* profiler =
+          GetStyleEngine().GetInvalidationSetProfiler()) {
+    profiler->DidUpdateStyle();
+  }
 
   ClearChildNeedsStyleRecalc();
 
@@ -8327,6 +8333,7 @@ void Document::Trace(Visitor* visitor) {
   visitor->Trace(mime_handler_view_before_unload_event_listener_);
   visitor->Trace(element_explicitly_set_attr_elements_map_);
   visitor->Trace(display_lock_activation_observer_);
+  visitor->Trace(display_lock_auto_observer_);
   Supplementable<Document>::Trace(visitor);
   TreeScope::Trace(visitor);
   ContainerNode::Trace(visitor);
@@ -8563,6 +8570,37 @@ void Document::ProcessDisplayLockActivationObservation(
   }
 }
 
+void Document::RegisterDisplayLockAutoObservation(Element* element) {
+  EnsureDisplayLockAutoObserver().observe(element);
+}
+
+void Document::UnregisterDisplayLockAutoObservation(Element* element) {
+  EnsureDisplayLockAutoObserver().unobserve(element);
+}
+
+IntersectionObserver& Document::EnsureDisplayLockAutoObserver() {
+  if (!display_lock_auto_observer_) {
+    // Commit elements a viewport height ahead of scrolling into them, so that
+    // their contents are usually laid out by the time they become visible.
+    // As above, use kPostTaskToDeliver since locking and committing dirty
+    // style and layout.
+    display_lock_auto_observer_ = IntersectionObserver::Create(
+        {Length::Percent(100)}, {std::numeric_limits<float>::min()}, this,
+        WTF::BindRepeating(&Document::ProcessDisplayLockAutoObservation,
+                           WrapWeakPersistent(this)),
+        IntersectionObserver::kPostTaskToDeliver);
+  }
+  return *display_lock_auto_observer_;
+}
+
+void Document::ProcessDisplayLockAutoObservation(
+    const HeapVector<Member<IntersectionObserverEntry>>& entries) {
+  for (auto& entry : entries) {
+    if (auto* context = entry->target()->GetDisplayLockContext())
+      context->NotifyIsNearViewport(entry->isIntersecting());
+  }
+}
+
 void Document::ExecuteJavaScriptUrls() {
   DCHECK(frame_);
   Vector<PendingJavascriptUrl> urls_to_execute;
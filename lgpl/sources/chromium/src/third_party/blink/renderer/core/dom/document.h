@@ -1555,6 +1555,11 @@ class CORE_EXPORT Document : public ContainerNode,
   void RegisterDisplayLockActivationObservation(Element*);
   void UnregisterDisplayLockActivationObservation(Element*);
 
+  // Manage the observation of elements with auto display locks, which are
+  // locked and committed as they move away from or near to the viewport.
+  void RegisterDisplayLockAutoObservation(Element*);
+  void UnregisterDisplayLockAutoObservation(Element*);
+
   // Deferred compositor commits are disallowed by default, and are only allowed
   // for same-origin navigations to an html document fetched with http.
   bool DeferredCompositorCommitIsAllowed() {
@@ -1794,6 +1799,11 @@ class CORE_EXPORT Document : public ContainerNode,
   void ProcessDisplayLockActivationObservation(
       const HeapVector<Member<IntersectionObserverEntry>>&);
 
+  IntersectionObserver& EnsureDisplayLockAutoObserver();
+
+  void ProcessDisplayLockAutoObservation(
+      const HeapVector<Member<IntersectionObserverEntry>>&);
+
   DocumentLifecycle lifecycle_;
 
   bool evaluate_media_queries_on_style_recalc_;
@@ -2158,6 +2168,7 @@ class CORE_EXPORT Document : public ContainerNode,
       element_explicitly_set_attr_elements_map_;
 
   Member<IntersectionObserver> display_lock_activation_observer_;
+  Member<IntersectionObserver> display_lock_auto_observer_;
 };
 
 extern template class CORE_EXTERN_TEMPLATE_EXPORT Supplement<Document>;
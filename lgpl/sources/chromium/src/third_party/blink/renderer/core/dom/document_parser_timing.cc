@@ -4,6 +4,8 @@
 
 #include "third_party/blink/renderer/core/dom/document_parser_timing.h"
 
+#include <algorithm>
+
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/loader/document_loader.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
@@ -66,6 +68,20 @@ void DocumentParserTiming::RecordParserBlockedOnScriptExecutionDuration(
   NotifyDocumentParserTimingChanged();
 }
 
+void DocumentParserTiming::RecordParserPump(base::TimeDelta duration,
+                                            size_t token_count,
+                                            bool yielded) {
+  if (parser_detached_ || parser_start_.is_null() || !parser_stop_.is_null())
+    return;
+  ++parser_pump_count_;
+  if (yielded)
+    ++parser_pump_yield_count_;
+  parser_pump_token_count_ += token_count;
+  parser_pump_duration_ += duration;
+  longest_parser_pump_duration_ =
+      std::max(longest_parser_pump_duration_, duration);
+}
+
 void DocumentParserTiming::Trace(Visitor* visitor) {
   Supplement<Document>::Trace(visitor);
 }
@@ -62,6 +62,14 @@ class DocumentParserTiming final
       base::TimeDelta duration,
       bool script_inserted_via_document_write);
 
+  // Record one main-thread pump of tokens produced by the background parser:
+  // how long it ran, how many tokens it processed, and whether it yielded
+  // with parsing left to do. Unlike the methods above, this does not notify
+  // the loader, since it is called for every pump.
+  void RecordParserPump(base::TimeDelta duration,
+                        size_t token_count,
+                        bool yielded);
+
   // The getters below return monotonically-increasing time, or zero if the
   // given parser event has not yet occurred.
 
@@ -97,6 +105,15 @@ class DocumentParserTiming final
     return parser_blocked_on_script_execution_from_document_write_duration_;
   }
 
+  // Per-pump statistics reported via RecordParserPump.
+  size_t ParserPumpCount() const { return parser_pump_count_; }
+  size_t ParserPumpYieldCount() const { return parser_pump_yield_count_; }
+  size_t ParserPumpTokenCount() const { return parser_pump_token_count_; }
+  base::TimeDelta ParserPumpDuration() const { return parser_pump_duration_; }
+  base::TimeDelta LongestParserPumpDuration() const {
+    return longest_parser_pump_duration_;
+  }
+
   void Trace(Visitor*) override;
 
  private:
@@ -109,6 +126,11 @@ class DocumentParserTiming final
   base::TimeDelta parser_blocked_on_script_execution_duration_;
   base::TimeDelta
       parser_blocked_on_script_execution_from_document_write_duration_;
+  size_t parser_pump_count_ = 0;
+  size_t parser_pump_yield_count_ = 0;
+  size_t parser_pump_token_count_ = 0;
+  base::TimeDelta parser_pump_duration_;
+  base::TimeDelta longest_parser_pump_duration_;
   bool parser_detached_ = false;
   DISALLOW_COPY_AND_ASSIGN(DocumentParserTiming);
 };
@@ -2385,6 +2385,7 @@ void Element::AttributeChanged(const AttributeModificationParams& params) {
       }
 
       EnsureDisplayLockContext().SetActivatable(activation_mask);
+      GetDisplayLockContext()->SetIsAuto(tokens.Contains("auto"));
       const bool should_be_invisible = tokens.Contains("invisible");
       if (should_be_invisible) {
         if (!GetDisplayLockContext()->IsLocked())
@@ -3159,6 +3160,11 @@ StyleRecalcChange Element::RecalcOwnStyle(const StyleRecalcChange change) {
   ComputedStyle::Difference diff =
       ComputedStyle::ComputeDifference(old_style.get(), new_style.get());
 
+  if (InvalidationSetProfiler* profiler =
+          GetDocument().GetStyleEngine().GetInvalidationSetProfiler()) {
+    profiler->DidRecalcStyle(*this, diff != ComputedStyle::Difference::kEqual);
+  }
+
   if (old_style && old_style->IsEnsuredInDisplayNone()) {
     // Make sure we traverse children for clearing ensured computed styles
     // further down the tree.
@@ -617,14 +617,30 @@ void LocalFrameView::PrepareLayoutAnalyzer() {
   TRACE_EVENT_CATEGORY_GROUP_ENABLED(
       TRACE_DISABLED_BY_DEFAULT("blink.debug.layout"), &is_tracing);
   if (!is_tracing) {
-    analyzer_.reset();
+    if (!RuntimeEnabledFeatures::LayoutAnalyzerTimingEnabled()) {
+      analyzer_.reset();
+      return;
+    }
+    // A timing-only analyzer accumulates over all the layouts of a frame, and
+    // is reset in ReportLayoutAnalyzerFrameStats().
+    if (!analyzer_ || !analyzer_->IsTimingOnly())
+      analyzer_ = std::make_unique<LayoutAnalyzer>(/* timing_only */ true);
     return;
   }
-  if (!analyzer_)
+  if (!analyzer_ || analyzer_->IsTimingOnly())
     analyzer_ = std::make_unique<LayoutAnalyzer>();
   analyzer_->Reset();
 }
 
+void LocalFrameView::ReportLayoutAnalyzerFrameStats() {
+  if (!analyzer_ || !analyzer_->IsTimingOnly() || !GetLayoutView())
+    return;
+  TRACE_EVENT_INSTANT1("blink,rail", "LocalFrameView::layoutAnalyzerFrameStats",
+                       TRACE_EVENT_SCOPE_THREAD, "counters",
+                       AnalyzerCounters());
+  analyzer_->Reset();
+}
+
 std::unique_ptr<TracedValue> LocalFrameView::AnalyzerCounters() {
   if (!analyzer_)
     return std::make_unique<TracedValue>();
@@ -2265,6 +2281,12 @@ bool LocalFrameView::UpdateLifecyclePhases(
     });
   }
 
+  // The observers above can still read the layout statistics of this frame
+  // from GetLayoutAnalyzer().
+  ForAllNonThrottledLocalFrameViews([](LocalFrameView& frame_view) {
+    frame_view.ReportLayoutAnalyzerFrameStats();
+  });
+
   return Lifecycle().GetState() == target_state;
 }
 
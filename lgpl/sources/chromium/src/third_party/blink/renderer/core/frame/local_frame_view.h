@@ -807,6 +807,9 @@ class CORE_EXPORT LocalFrameView final
 
   void PrepareLayoutAnalyzer();
   std::unique_ptr<TracedValue> AnalyzerCounters();
+  // Emits and resets the statistics of a timing-only LayoutAnalyzer at the end
+  // of a lifecycle update.
+  void ReportLayoutAnalyzerFrameStats();
 
   void CollectAnnotatedRegions(LayoutObject&,
                                Vector<AnnotatedRegionValue>&) const;
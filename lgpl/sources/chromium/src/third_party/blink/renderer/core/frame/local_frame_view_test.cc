@@ -9,6 +9,7 @@
 #include "testing/gmock/include/gmock/gmock.h"
 #include "third_party/blink/renderer/core/html/html_anchor_element.h"
 #include "third_party/blink/renderer/core/html/html_element.h"
+#include "third_party/blink/renderer/core/layout/layout_analyzer.h"
 #include "third_party/blink/renderer/core/layout/layout_view.h"
 #include "third_party/blink/renderer/core/paint/paint_layer.h"
 #include "third_party/blink/renderer/core/paint/paint_layer_scrollable_area.h"
@@ -186,6 +187,28 @@ TEST_F(LocalFrameViewTest, CanHaveScrollbarsIfScrollingAttrEqualsNoChanged) {
   EXPECT_TRUE(ChildDocument().View()->CanHaveScrollbars());
 }
 
+TEST_F(LocalFrameViewTest, LayoutAnalyzerTimingAccumulatesOverFrame) {
+  ScopedLayoutAnalyzerTimingForTest layout_analyzer_timing(true);
+  SetBodyInnerHTML("<div id='target' style='width: 100px'>Some text</div>");
+  const LayoutAnalyzer* analyzer = GetDocument().View()->GetLayoutAnalyzer();
+  ASSERT_TRUE(analyzer);
+  EXPECT_TRUE(analyzer->IsTimingOnly());
+  // The statistics are reset at the end of every lifecycle update.
+  EXPECT_EQ(0u, analyzer->GetCounter(LayoutAnalyzer::kNGLinesLaidOut));
+
+  // A forced layout is accounted to the next frame.
+  GetDocument().getElementById("target")->setAttribute(html_names::kStyleAttr,
+                                                       "width: 50px");
+  GetDocument().UpdateStyleAndLayout();
+  EXPECT_GT(analyzer->GetCounter(LayoutAnalyzer::kNGLinesLaidOut), 0u);
+  EXPECT_GT(analyzer->GetCounter(LayoutAnalyzer::kNGLayoutResultCacheMisses),
+            0u);
+
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_EQ(analyzer, GetDocument().View()->GetLayoutAnalyzer());
+  EXPECT_EQ(0u, analyzer->GetCounter(LayoutAnalyzer::kNGLinesLaidOut));
+}
+
 // Ensure the fragment navigation "scroll into view and focus" behavior doesn't
 // activate synchronously while rendering is blocked waiting on a stylesheet.
 // See https://crbug.com/851338.
@@ -155,12 +155,15 @@ class CORE_EXPORT AtomicHTMLToken {
         attributes_.ReserveInitialCapacity(token.Attributes().size());
         for (const CompactHTMLToken::Attribute& attribute :
              token.Attributes()) {
-          QualifiedName name(g_null_atom, AtomicString(attribute.GetName()),
+          // Atomize straight from the chunk's arena; names and values that
+          // are already atomic do not allocate.
+          QualifiedName name(g_null_atom,
+                             attribute.NameView().ToAtomicString(),
                              g_null_atom);
           // FIXME: This is N^2 for the number of attributes.
           if (!FindAttributeInVector(attributes_, name)) {
             attributes_.push_back(
-                Attribute(name, AtomicString(attribute.Value())));
+                Attribute(name, attribute.ValueView().ToAtomicString()));
           } else {
             duplicate_attribute_ = true;
           }
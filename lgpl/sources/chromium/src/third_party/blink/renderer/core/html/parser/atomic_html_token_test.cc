@@ -43,6 +43,7 @@ TEST(AtomicHTMLTokenTest, EmptyAttributeValueFromHTMLToken) {
 
 TEST(AtomicHTMLTokenTest, EmptyAttributeValueFromCompactHTMLToken) {
   HTMLToken token;
+  CompactHTMLTokenArena arena;
   token.BeginStartTag('a');
   token.AddNewAttribute();
   token.BeginAttributeName(3);
@@ -55,7 +56,7 @@ TEST(AtomicHTMLTokenTest, EmptyAttributeValueFromCompactHTMLToken) {
   token.BeginAttributeValue(8);
   token.EndAttributeValue(8);
 
-  AtomicHTMLToken atoken(CompactHTMLToken(&token, TextPosition()));
+  AtomicHTMLToken atoken(CompactHTMLToken(&token, TextPosition(), arena));
 
   const blink::Attribute* attribute_b = atoken.GetAttributeItem(
       QualifiedName(AtomicString(), "b", AtomicString()));
@@ -32,7 +32,10 @@
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/renderer/core/html/parser/html_document_parser.h"
 #include "third_party/blink/renderer/core/html/parser/text_resource_decoder.h"
+#include "third_party/blink/renderer/core/html/parser/html_parser_idioms.h"
 #include "third_party/blink/renderer/core/html_names.h"
+#include "third_party/blink/renderer/core/mathml_names.h"
+#include "third_party/blink/renderer/core/svg_names.h"
 #include "third_party/blink/renderer/platform/instrumentation/histogram.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
 #include "third_party/blink/renderer/platform/wtf/cross_thread_functional.h"
@@ -41,6 +44,8 @@
 
 namespace blink {
 
+using namespace html_names;
+
 // On a network with high latency and high bandwidth, using a device with a fast
 // CPU, we could end up speculatively tokenizing the whole document, well ahead
 // of when the main-thread actually needs it. This is a waste of memory (and
@@ -63,6 +68,57 @@ static const size_t kPendingTokenLimit = 1000;
 static_assert(kOutstandingTokenLimit > kPendingTokenLimit,
               "Outstanding token limit is applied after pending token limit.");
 
+// Whether inserting the element for |token| may run script, or affect the
+// document or elements outside of its own subtree, so that the main thread
+// has to attach it to the document as soon as it is parsed rather than as
+// part of a detached subtree. See
+// HTMLConstructionSite::SetDefersSubtreeAttachment().
+static bool NeedsImmediateAttachment(const CompactHTMLToken& token) {
+  if (token.GetType() == HTMLToken::kEndOfFile)
+    return true;
+  if (token.GetType() != HTMLToken::kStartTag)
+    return false;
+  if (token.GetAttributeItem(kIsAttr) ||
+      token.GetAttributeItem(kContenteditableAttr))
+    return true;
+  const String& tag_name = token.Data();
+  // Any name that may be a valid custom element name; this is the quick check
+  // of CustomElement::IsValidName(), which can't be used off the main thread.
+  // The constructor of a defined custom element runs synchronously.
+  if (tag_name.find('-', 1) != kNotFound)
+    return true;
+  return ThreadSafeMatch(tag_name, kHTMLTag) ||
+         ThreadSafeMatch(tag_name, kHeadTag) ||
+         ThreadSafeMatch(tag_name, kBodyTag) ||
+         ThreadSafeMatch(tag_name, kBaseTag) ||
+         ThreadSafeMatch(tag_name, kMetaTag) ||
+         ThreadSafeMatch(tag_name, kTitleTag) ||
+         ThreadSafeMatch(tag_name, kLinkTag) ||
+         ThreadSafeMatch(tag_name, kStyleTag) ||
+         ThreadSafeMatch(tag_name, kScriptTag) ||
+         ThreadSafeMatch(tag_name, kTemplateTag) ||
+         ThreadSafeMatch(tag_name, kFormTag) ||
+         ThreadSafeMatch(tag_name, kInputTag) ||
+         ThreadSafeMatch(tag_name, kButtonTag) ||
+         ThreadSafeMatch(tag_name, kSelectTag) ||
+         ThreadSafeMatch(tag_name, kTextareaTag) ||
+         ThreadSafeMatch(tag_name, kOutputTag) ||
+         ThreadSafeMatch(tag_name, kFieldsetTag) ||
+         ThreadSafeMatch(tag_name, kKeygenTag) ||
+         ThreadSafeMatch(tag_name, kDatalistTag) ||
+         ThreadSafeMatch(tag_name, kObjectTag) ||
+         ThreadSafeMatch(tag_name, kEmbedTag) ||
+         ThreadSafeMatch(tag_name, kAppletTag) ||
+         ThreadSafeMatch(tag_name, kIFrameTag) ||
+         ThreadSafeMatch(tag_name, kFrameTag) ||
+         ThreadSafeMatch(tag_name, kFramesetTag) ||
+         ThreadSafeMatch(tag_name, kPortalTag) ||
+         ThreadSafeMatch(tag_name, kAudioTag) ||
+         ThreadSafeMatch(tag_name, kVideoTag) ||
+         ThreadSafeMatch(tag_name, svg_names::kSVGTag) ||
+         ThreadSafeMatch(tag_name, mathml_names::kMathTag);
+}
+
 base::WeakPtr<BackgroundHTMLParser> BackgroundHTMLParser::Create(
     std::unique_ptr<Configuration> config,
     scoped_refptr<base::SingleThreadTaskRunner> loading_task_runner) {
@@ -94,6 +150,7 @@ BackgroundHTMLParser::BackgroundHTMLParser(
       tree_builder_simulator_(config->options),
       options_(config->options),
       parser_(config->parser),
+      pending_token_arena_(std::make_unique<CompactHTMLTokenArena>()),
       decoder_(std::move(config->decoder)),
       loading_task_runner_(std::move(loading_task_runner)),
       pending_csp_meta_token_index_(
@@ -195,7 +252,7 @@ void BackgroundHTMLParser::PumpTokenizer() {
       TextPosition position = TextPosition(input_.Current().CurrentLine(),
                                            input_.Current().CurrentColumn());
 
-      CompactHTMLToken token(token_.get(), position);
+      CompactHTMLToken token(token_.get(), position, *pending_token_arena_);
       bool is_csp_meta_tag = false;
       preload_scanner_->Scan(token, input_.Current(), pending_preloads_,
                              &viewport_description_, &is_csp_meta_tag);
@@ -209,8 +266,16 @@ void BackgroundHTMLParser::PumpTokenizer() {
       if (simulated_token == HTMLTreeBuilderSimulator::kValidScriptStart) {
         EnqueueTokenizedChunk();
         starting_script_ = true;
+        // The script token starts the next chunk, so its attributes have to
+        // live in that chunk's arena.
+        token = CompactHTMLToken(token_.get(), position, *pending_token_arena_);
       }
 
+      if (simulated_token != HTMLTreeBuilderSimulator::kOtherToken ||
+          tree_builder_simulator_.InForeignContent() ||
+          NeedsImmediateAttachment(token))
+        pending_tokens_need_immediate_attachment_ = true;
+
       pending_tokens_.push_back(token);
       if (is_csp_meta_tag) {
         pending_csp_meta_token_index_ = pending_tokens_.size() - 1;
@@ -253,9 +318,14 @@ void BackgroundHTMLParser::EnqueueTokenizedChunk() {
   chunk->input_checkpoint = input_.CreateCheckpoint(pending_tokens_.size());
   chunk->preload_scanner_checkpoint = preload_scanner_->CreateCheckpoint();
   chunk->tokens.swap(pending_tokens_);
+  chunk->token_arena = std::move(pending_token_arena_);
+  pending_token_arena_ = std::make_unique<CompactHTMLTokenArena>();
   chunk->starting_script = starting_script_;
+  chunk->can_defer_subtree_attachment =
+      !starting_script_ && !pending_tokens_need_immediate_attachment_;
   chunk->pending_csp_meta_token_index = pending_csp_meta_token_index_;
   starting_script_ = false;
+  pending_tokens_need_immediate_attachment_ = false;
   pending_csp_meta_token_index_ =
       HTMLDocumentParser::TokenizedChunk::kNoPendingToken;
 
@@ -114,6 +114,9 @@ class BackgroundHTMLParser {
   base::WeakPtr<HTMLDocumentParser> parser_;
 
   CompactHTMLTokenStream pending_tokens_;
+  // Holds the attribute characters of |pending_tokens_|, and moves to the
+  // main thread with them.
+  std::unique_ptr<CompactHTMLTokenArena> pending_token_arena_;
   PreloadRequestStream pending_preloads_;
   base::Optional<ViewportDescription> viewport_description_;
   std::unique_ptr<TokenPreloadScanner> preload_scanner_;
@@ -127,6 +130,10 @@ class BackgroundHTMLParser {
 
   bool starting_script_;
 
+  // Whether |pending_tokens_| contain an element that the main thread has to
+  // insert into the document as soon as it is parsed.
+  bool pending_tokens_need_immediate_attachment_ = false;
+
   base::WeakPtrFactory<BackgroundHTMLParser> weak_factory_{this};
 
   DISALLOW_COPY_AND_ASSIGN(BackgroundHTMLParser);
@@ -25,6 +25,8 @@
 
 #include "third_party/blink/renderer/core/html/parser/compact_html_token.h"
 
+#include <algorithm>
+
 #include "third_party/blink/renderer/core/dom/qualified_name.h"
 #include "third_party/blink/renderer/core/html/parser/html_parser_idioms.h"
 
@@ -40,8 +42,53 @@ struct SameSizeAsCompactHTMLToken {
 static_assert(sizeof(CompactHTMLToken) == sizeof(SameSizeAsCompactHTMLToken),
               "CompactHTMLToken should stay small");
 
+CompactHTMLTokenArena::CompactHTMLTokenArena() = default;
+
+CompactHTMLTokenArena::~CompactHTMLTokenArena() = default;
+
+void* CompactHTMLTokenArena::Allocate(size_t size, size_t alignment) {
+  size_t padding = -reinterpret_cast<uintptr_t>(position_) & (alignment - 1);
+  if (position_ && padding + size <= static_cast<size_t>(end_ - position_)) {
+    char* result = position_ + padding;
+    position_ = result + size;
+    return result;
+  }
+
+  // Strings that would take up most of a block get a block of their own, so
+  // that the rest of the current block is not wasted.
+  if (size > kBlockSize / 2) {
+    blocks_.push_back(std::unique_ptr<char[]>(new char[size]));
+    return blocks_.back().get();
+  }
+  blocks_.push_back(std::unique_ptr<char[]>(new char[kBlockSize]));
+  char* result = blocks_.back().get();
+  position_ = result + size;
+  end_ = result + kBlockSize;
+  return result;
+}
+
+StringView CompactHTMLTokenArena::Copy(const UChar* characters,
+                                       wtf_size_t length) {
+  if (!length)
+    return StringView(StringImpl::empty_);
+
+  UChar ored = 0;
+  for (wtf_size_t i = 0; i < length; ++i)
+    ored |= characters[i];
+  if (!(ored & ~0xFF)) {
+    LChar* copy = static_cast<LChar*>(Allocate(length, alignof(LChar)));
+    std::copy(characters, characters + length, copy);
+    return StringView(copy, length);
+  }
+  UChar* copy =
+      static_cast<UChar*>(Allocate(length * sizeof(UChar), alignof(UChar)));
+  std::copy(characters, characters + length, copy);
+  return StringView(copy, length);
+}
+
 CompactHTMLToken::CompactHTMLToken(const HTMLToken* token,
-                                   const TextPosition& text_position)
+                                   const TextPosition& text_position,
+                                   CompactHTMLTokenArena& arena)
     : type_(token->GetType()),
       is_all8_bit_data_(false),
       doctype_forces_quirks_(false),
@@ -55,9 +102,11 @@ CompactHTMLToken::CompactHTMLToken(const HTMLToken* token,
 
       // There is only 1 DOCTYPE token per document, so to avoid increasing the
       // size of CompactHTMLToken, we just use the attributes_ vector.
+      const Vector<UChar>& public_identifier = token->PublicIdentifier();
+      const Vector<UChar>& system_identifier = token->SystemIdentifier();
       attributes_.push_back(Attribute(
-          AttemptStaticStringCreation(token->PublicIdentifier(), kLikely8Bit),
-          String(token->SystemIdentifier())));
+          arena.Copy(public_identifier.data(), public_identifier.size()),
+          arena.Copy(system_identifier.data(), system_identifier.size())));
       doctype_forces_quirks_ = token->ForceQuirks();
       break;
     }
@@ -65,10 +114,13 @@ CompactHTMLToken::CompactHTMLToken(const HTMLToken* token,
       break;
     case HTMLToken::kStartTag:
       attributes_.ReserveInitialCapacity(token->Attributes().size());
-      for (const HTMLToken::Attribute& attribute : token->Attributes())
+      for (const HTMLToken::Attribute& attribute : token->Attributes()) {
+        const Vector<UChar, 32>& name = attribute.NameAsVector();
+        const Vector<UChar, 32>& value = attribute.ValueAsVector();
         attributes_.push_back(
-            Attribute(attribute.NameAttemptStaticStringCreation(),
-                      attribute.Value8BitIfNecessary()));
+            Attribute(arena.Copy(name.data(), name.size()),
+                      arena.Copy(value.data(), value.size())));
+      }
       FALLTHROUGH;
     case HTMLToken::kEndTag:
       self_closing_ = token->SelfClosing();
@@ -89,7 +141,7 @@ CompactHTMLToken::CompactHTMLToken(const HTMLToken* token,
 const CompactHTMLToken::Attribute* CompactHTMLToken::GetAttributeItem(
     const QualifiedName& name) const {
   for (unsigned i = 0; i < attributes_.size(); ++i) {
-    if (ThreadSafeMatch(attributes_.at(i).GetName(), name))
+    if (ThreadSafeMatch(attributes_.at(i).NameView(), name))
       return &attributes_.at(i);
   }
   return nullptr;
@@ -26,8 +26,12 @@
 #ifndef THIRD_PARTY_BLINK_RENDERER_CORE_HTML_PARSER_COMPACT_HTML_TOKEN_H_
 #define THIRD_PARTY_BLINK_RENDERER_CORE_HTML_PARSER_COMPACT_HTML_TOKEN_H_
 
+#include <memory>
+
+#include "base/macros.h"
 #include "third_party/blink/renderer/core/html/parser/html_token.h"
 #include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_view.h"
 #include "third_party/blink/renderer/platform/wtf/text/text_position.h"
 #include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
 #include "third_party/blink/renderer/platform/wtf/vector.h"
@@ -36,6 +40,35 @@ namespace blink {
 
 class QualifiedName;
 
+// Holds the characters of the attribute names and values of a run of
+// CompactHTMLTokens, so that tokenizing a start tag does not allocate a String
+// per attribute. The tokens refer to the characters in place, so the arena
+// must outlive them; characters are never moved once copied in. The arena is
+// filled on the background parser thread and then handed to the main thread
+// along with the tokens.
+class CORE_EXPORT CompactHTMLTokenArena {
+  USING_FAST_MALLOC(CompactHTMLTokenArena);
+
+ public:
+  CompactHTMLTokenArena();
+  ~CompactHTMLTokenArena();
+
+  // Copies |characters| into the arena, as 8-bit characters if they all fit,
+  // and returns a view of the copy. The view of an empty string is not null.
+  StringView Copy(const UChar* characters, wtf_size_t length);
+
+ private:
+  void* Allocate(size_t size, size_t alignment);
+
+  static constexpr size_t kBlockSize = 8192;
+
+  Vector<std::unique_ptr<char[]>> blocks_;
+  char* position_ = nullptr;
+  char* end_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(CompactHTMLTokenArena);
+};
+
 class CORE_EXPORT CompactHTMLToken {
   DISALLOW_NEW();
 
@@ -44,21 +77,28 @@ class CORE_EXPORT CompactHTMLToken {
     DISALLOW_NEW();
 
    public:
-    Attribute(const String& name, const String& value)
+    Attribute(const StringView& name, const StringView& value)
         : name_(name), value_(value) {}
 
-    const String& GetName() const { return name_; }
-    const String& Value() const { return value_; }
+    // Views of the characters in the CompactHTMLTokenArena, which the main
+    // thread can atomize without an intermediate String.
+    const StringView& NameView() const { return name_; }
+    const StringView& ValueView() const { return value_; }
 
-    // We don't create a new 8-bit String because it doesn't save memory.
-    const String& Value8BitIfNecessary() const { return value_; }
+    // These create a new String from the arena characters.
+    String GetName() const { return name_.ToString(); }
+    String Value() const { return value_.ToString(); }
+    String Value8BitIfNecessary() const { return Value(); }
 
    private:
-    String name_;
-    String value_;
+    StringView name_;
+    StringView value_;
   };
 
-  CompactHTMLToken(const HTMLToken*, const TextPosition&);
+  // Attribute and DOCTYPE identifier characters are copied into |arena|.
+  CompactHTMLToken(const HTMLToken*,
+                   const TextPosition&,
+                   CompactHTMLTokenArena& arena);
 
   HTMLToken::TokenType GetType() const {
     return static_cast<HTMLToken::TokenType>(type_);
@@ -72,8 +112,8 @@ class CORE_EXPORT CompactHTMLToken {
 
   // There is only 1 DOCTYPE token per document, so to avoid increasing the
   // size of CompactHTMLToken, we just use the attributes_ vector.
-  const String& PublicIdentifier() const { return attributes_[0].GetName(); }
-  const String& SystemIdentifier() const { return attributes_[0].Value(); }
+  String PublicIdentifier() const { return attributes_[0].GetName(); }
+  String SystemIdentifier() const { return attributes_[0].Value(); }
   bool DoctypeForcesQuirks() const { return doctype_forces_quirks_; }
 
  private:
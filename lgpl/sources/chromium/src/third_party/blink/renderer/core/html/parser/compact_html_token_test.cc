@@ -5,11 +5,13 @@
 #include "third_party/blink/renderer/core/html/parser/compact_html_token.h"
 
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
 
 namespace blink {
 
 TEST(CompactHTMLTokenTest, EmptyAttributeValueFromHTMLToken) {
   HTMLToken token;
+  CompactHTMLTokenArena arena;
   token.BeginStartTag('a');
   token.AddNewAttribute();
   token.BeginAttributeName(3);
@@ -22,7 +24,7 @@ TEST(CompactHTMLTokenTest, EmptyAttributeValueFromHTMLToken) {
   token.BeginAttributeValue(8);
   token.EndAttributeValue(8);
 
-  CompactHTMLToken ctoken(&token, TextPosition());
+  CompactHTMLToken ctoken(&token, TextPosition(), arena);
 
   const CompactHTMLToken::Attribute* attribute_b = ctoken.GetAttributeItem(
       QualifiedName(AtomicString(), "b", AtomicString()));
@@ -41,4 +43,33 @@ TEST(CompactHTMLTokenTest, EmptyAttributeValueFromHTMLToken) {
   EXPECT_FALSE(attribute_d);
 }
 
+TEST(CompactHTMLTokenTest, ArenaKeepsCopiesInPlace) {
+  CompactHTMLTokenArena arena;
+  Vector<String> strings;
+  Vector<StringView> copies;
+  for (unsigned i = 0; i < 1000; ++i) {
+    StringBuilder builder;
+    builder.Append("value");
+    builder.AppendNumber(i);
+    // Every third string needs 16 bits, and one is long enough to get a block
+    // of its own.
+    if (i % 3 == 0)
+      builder.Append(static_cast<UChar>(0x3042));
+    if (i == 500) {
+      for (unsigned j = 0; j < 10000; ++j)
+        builder.Append('x');
+    }
+    String string = builder.ToString();
+    string.Ensure16Bit();
+    copies.push_back(arena.Copy(string.Characters16(), string.length()));
+    strings.push_back(string);
+  }
+
+  for (unsigned i = 0; i < strings.size(); ++i) {
+    EXPECT_EQ(i % 3 != 0, copies[i].Is8Bit());
+    EXPECT_EQ(strings[i], copies[i].ToString());
+  }
+  EXPECT_FALSE(arena.Copy(nullptr, 0).IsNull());
+}
+
 }  // namespace blink
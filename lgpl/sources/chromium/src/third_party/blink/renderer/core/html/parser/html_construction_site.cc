@@ -172,6 +172,9 @@ static inline void ExecuteTakeAllChildrenTask(HTMLConstructionSiteTask& task) {
 
 void HTMLConstructionSite::ExecuteTask(HTMLConstructionSiteTask& task) {
   DCHECK(task_queue_.IsEmpty());
+  if (defers_subtree_attachment_ && DeferTask(task))
+    return;
+
   if (task.operation == HTMLConstructionSiteTask::kInsert)
     return ExecuteInsertTask(task);
 
@@ -192,6 +195,108 @@ void HTMLConstructionSite::ExecuteTask(HTMLConstructionSiteTask& task) {
   NOTREACHED();
 }
 
+// Returns whether |task| was held back until AttachDeferredSubtrees().
+bool HTMLConstructionSite::DeferTask(HTMLConstructionSiteTask& task) {
+  DCHECK(defers_subtree_attachment_);
+  bool is_append = (task.operation == HTMLConstructionSiteTask::kInsert ||
+                    task.operation == HTMLConstructionSiteTask::kInsertText) &&
+                   !task.next_child;
+  if (!is_append) {
+    // Everything else, such as the adoption agency, expects the tree to be
+    // up to date.
+    AttachDeferredSubtrees();
+    return false;
+  }
+
+  // Building a detached subtree; nothing outside of it can observe this.
+  if (!task.parent->isConnected())
+    return false;
+
+  // The element is parsed as if it had been inserted; only the insertion
+  // itself waits.
+  if (task.operation == HTMLConstructionSiteTask::kInsert) {
+    if (auto* child = DynamicTo<Element>(task.child.Get())) {
+      child->BeginParsingChildren();
+      if (task.self_closing)
+        child->FinishParsingChildren();
+    }
+  }
+  deferred_tasks_.push_back(task);
+  return true;
+}
+
+void HTMLConstructionSite::SetDefersSubtreeAttachment(bool defers) {
+  // Form-associated elements resolve their form owner when inserted.
+  if (defers && form_)
+    return;
+  if (!defers)
+    AttachDeferredSubtrees();
+  defers_subtree_attachment_ = defers;
+  open_elements_.SetDeferredAttachmentSite(defers ? this : nullptr);
+}
+
+// Appends a run of deferred children of |parent|, with one DOM tree version
+// bump and node list invalidation for the whole run where possible. Tasks of
+// the regular queue are still inserted one by one: the queue rarely holds more
+// than one append to the same parent, and script run by the insertion of one
+// element (e.g. a subframe load) must not see its later siblings.
+static void AppendDeferredChildren(ContainerNode& parent,
+                                   NodeVector& children) {
+  if (children.IsEmpty())
+    return;
+
+  CEReactionsScope reactions;
+  // The document checks each child it accepts.
+  if (children.size() == 1 || parent.IsDocumentNode()) {
+    for (const auto& child : children)
+      parent.ParserAppendChild(child);
+  } else {
+    parent.ParserAppendChildren(children);
+  }
+  children.clear();
+}
+
+void HTMLConstructionSite::AttachDeferredSubtrees() {
+  if (deferred_tasks_.IsEmpty())
+    return;
+
+  TaskQueue tasks;
+  tasks.swap(deferred_tasks_);
+
+  // Deferred tasks only ever append to connected parents, so none of them
+  // targets a node of a pending run and consecutive tasks with the same
+  // parent can be appended together.
+  ContainerNode* run_parent = nullptr;
+  NodeVector run;
+  for (auto& task : tasks) {
+    if (auto* template_element = ToHTMLTemplateElementOrNull(*task.parent))
+      task.parent = template_element->content();
+    if (task.parent != run_parent) {
+      if (run_parent)
+        AppendDeferredChildren(*run_parent, run);
+      run_parent = task.parent;
+    }
+
+    if (task.operation == HTMLConstructionSiteTask::kInsertText) {
+      // Same merging as ExecuteInsertTextTask(), against the pending run
+      // first.
+      auto* new_text = To<Text>(task.child.Get());
+      Node* previous_child =
+          run.IsEmpty() ? run_parent->lastChild() : run.back().Get();
+      if (auto* previous_text = DynamicTo<Text>(previous_child)) {
+        unsigned length_limit = TextLengthLimitForContainer(*run_parent);
+        if (previous_text->length() + new_text->length() < length_limit) {
+          previous_text->ParserAppendData(new_text->data());
+          continue;
+        }
+      }
+    }
+    run.push_back(task.child);
+  }
+  if (run_parent)
+    AppendDeferredChildren(*run_parent, run);
+}
+
 // This is only needed for TextDocuments where we might have text nodes
 // approaching the default length limit (~64k) and we don't want to break a text
 // node in the middle of a combining character.
@@ -311,9 +416,11 @@ void HTMLConstructionSite::AttachLater(ContainerNode* parent,
 
   // Add as a sibling of the parent if we have reached the maximum depth
   // allowed.
-  if (open_elements_.StackDepth() > kMaximumHTMLParserDOMTreeDepth &&
-      task.parent->parentNode())
-    task.parent = task.parent->parentNode();
+  if (open_elements_.StackDepth() > kMaximumHTMLParserDOMTreeDepth) {
+    AttachDeferredSubtrees();
+    if (task.parent->parentNode())
+      task.parent = task.parent->parentNode();
+  }
 
   DCHECK(task.parent);
   QueueTask(task);
@@ -391,6 +498,7 @@ void HTMLConstructionSite::Trace(Visitor* visitor) {
   visitor->Trace(open_elements_);
   visitor->Trace(active_formatting_elements_);
   visitor->Trace(task_queue_);
+  visitor->Trace(deferred_tasks_);
   visitor->Trace(pending_text_);
 }
 
@@ -399,6 +507,9 @@ void HTMLConstructionSite::Detach() {
   // discarding text that really should have made it into the DOM earlier, but
   // there doesn't seem to be a nice way to do that.
   pending_text_.Discard();
+  deferred_tasks_.clear();
+  defers_subtree_attachment_ = false;
+  open_elements_.SetDeferredAttachmentSite(nullptr);
   document_ = nullptr;
   attachment_root_ = nullptr;
 }
@@ -897,6 +1008,12 @@ Element* HTMLConstructionSite::CreateElement(
   Element* element;
 
   if (will_execute_script) {
+    // The constructor and the reactions are author script, which has to see
+    // everything parsed so far in the document. Names registered by the
+    // embedder aren't caught by BackgroundHTMLParser, so check here too.
+    if (defers_subtree_attachment_)
+      SetDefersSubtreeAttachment(false);
+
     // "6.1 Increment the document's throw-on-dynamic-insertion counter."
     ThrowOnDynamicMarkupInsertionCountIncrementer
         throw_on_dynamic_markup_insertions(&document);
@@ -1064,6 +1181,9 @@ bool HTMLConstructionSite::InQuirksMode() {
 // foster parenting algorithm, laid out as the substeps of step 2 of
 // https://html.spec.whatwg.org/C/#appropriate-place-for-inserting-a-node
 void HTMLConstructionSite::FindFosterSite(HTMLConstructionSiteTask& task) {
+  // The foster site depends on where the last table is in the tree.
+  AttachDeferredSubtrees();
+
   // 2.1
   HTMLElementStack::ElementRecord* last_template =
       open_elements_.Topmost(kTemplateTag.LocalName());
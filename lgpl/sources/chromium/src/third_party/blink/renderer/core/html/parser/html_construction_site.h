@@ -139,6 +139,16 @@ class HTMLConstructionSite final {
     return !pending_text_.IsEmpty() || !task_queue_.IsEmpty();
   }
 
+  // While set, new subtrees are built detached: nodes are still inserted as
+  // soon as their tasks run if their parent is not connected, but insertions
+  // into the connected tree are held back until AttachDeferredSubtrees(), so
+  // that each new subtree becomes connected in one step instead of one node at
+  // a time. Only meant for stretches of markup whose elements have no effect
+  // when inserted beyond their own subtree; the caller checks that.
+  void SetDefersSubtreeAttachment(bool);
+  // NOTE: Possible reentrancy via JavaScript execution.
+  void AttachDeferredSubtrees();
+
   void SetDefaultCompatibilityMode();
   void ProcessEndOfFile();
   void FinishedParsing();
@@ -261,6 +271,7 @@ class HTMLConstructionSite final {
 
   void ExecuteTask(HTMLConstructionSiteTask&);
   void QueueTask(const HTMLConstructionSiteTask&);
+  bool DeferTask(HTMLConstructionSiteTask&);
 
   CustomElementDefinition* LookUpCustomElementDefinition(
       Document&,
@@ -284,6 +295,11 @@ class HTMLConstructionSite final {
 
   TaskQueue task_queue_;
 
+  // Insertions into the connected tree held back while
+  // |defers_subtree_attachment_| is set, in the order they were made.
+  TaskQueue deferred_tasks_;
+  bool defers_subtree_attachment_ = false;
+
   class PendingText final {
     DISALLOW_NEW();
 
@@ -99,6 +99,16 @@ static HTMLTokenizer::State TokenizerStateForContextElement(
   return HTMLTokenizer::kDataState;
 }
 
+// Insertions into detached subtrees are not seen by mutation observers and
+// mutation event listeners registered in the document.
+static bool DocumentObservesInsertions(const Document& document) {
+  return document.HasMutationObserversOfType(kMutationTypeChildList) ||
+         document.HasListenerType(Document::kDOMSubtreeModifiedListener) ||
+         document.HasListenerType(Document::kDOMNodeInsertedListener) ||
+         document.HasListenerType(
+             Document::kDOMNodeInsertedIntoDocumentListener);
+}
+
 HTMLDocumentParser::HTMLDocumentParser(HTMLDocument& document,
                                        ParserSynchronizationPolicy sync_policy)
     : HTMLDocumentParser(document, kAllowScriptingContent, sync_policy) {
@@ -510,6 +520,13 @@ size_t HTMLDocumentParser::ProcessTokenizedChunkFromBackgroundParser(
       FROM_HERE, WTF::Bind(&BackgroundHTMLParser::StartedChunkWithCheckpoint,
                            background_parser_, chunk->input_checkpoint));
 
+  bool defers_subtree_attachment =
+      chunk->can_defer_subtree_attachment &&
+      RuntimeEnabledFeatures::ParserDetachedSubtreeConstructionEnabled() &&
+      !DocumentObservesInsertions(*GetDocument());
+  if (defers_subtree_attachment)
+    tree_builder_->SetDefersSubtreeAttachment(true);
+
   for (const auto& token : tokens) {
     DCHECK(!IsWaitingForScripts());
 
@@ -553,6 +570,9 @@ size_t HTMLDocumentParser::ProcessTokenizedChunkFromBackgroundParser(
     DCHECK(!token_);
   }
 
+  if (defers_subtree_attachment && !IsStopped())
+    tree_builder_->SetDefersSubtreeAttachment(false);
+
   // Make sure all required pending text nodes are emitted before returning.
   // This leaves "script", "style" and "svg" nodes text nodes intact.
   if (!IsStopped())
@@ -592,9 +612,11 @@ void HTMLDocumentParser::PumpPendingSpeculations() {
   SpeculationsPumpSession session(pump_speculations_session_nesting_level_);
   while (!speculations_.IsEmpty()) {
     DCHECK(!IsScheduledForUnpause());
+    size_t token_count = speculations_.front()->tokens.size();
     size_t element_token_count =
         ProcessTokenizedChunkFromBackgroundParser(speculations_.TakeFirst());
     session.AddedElementTokens(element_token_count);
+    session.AddedTokens(token_count);
 
     // Always check IsParsing first as document_ may be null. Surprisingly,
     // IsScheduledForUnpause() may be set here as a result of
@@ -606,9 +628,14 @@ void HTMLDocumentParser::PumpPendingSpeculations() {
 
     if (speculations_.IsEmpty() ||
         parser_scheduler_->YieldIfNeeded(
-            session, speculations_.front()->starting_script))
+            session, speculations_.front()->starting_script,
+            speculations_.front()->tokens.size()))
       break;
   }
+
+  // The parser may have been detached by script run from the pump.
+  if (parser_scheduler_)
+    parser_scheduler_->DidPumpSpeculations(session);
 }
 
 void HTMLDocumentParser::ForcePlaintextForTextDocument() {
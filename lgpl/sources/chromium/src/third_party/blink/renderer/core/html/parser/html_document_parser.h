@@ -109,6 +109,9 @@ class CORE_EXPORT HTMLDocumentParser : public ScriptableDocumentParser,
     USING_FAST_MALLOC(TokenizedChunk);
 
    public:
+    // Owns the attribute characters that |tokens| refer to, so it is declared
+    // before them to be destroyed after them.
+    std::unique_ptr<CompactHTMLTokenArena> token_arena;
     CompactHTMLTokenStream tokens;
     PreloadRequestStream preloads;
     base::Optional<ViewportDescription> viewport;
@@ -117,6 +120,9 @@ class CORE_EXPORT HTMLDocumentParser : public ScriptableDocumentParser,
     HTMLInputCheckpoint input_checkpoint;
     TokenPreloadScannerCheckpoint preload_scanner_checkpoint;
     bool starting_script;
+    // Set when none of the elements in |tokens| have effects on insertion
+    // beyond their own subtree, so that their subtrees can be built detached.
+    bool can_defer_subtree_attachment;
     // Index into |tokens| of the last <meta> csp tag in |tokens|. Preloads will
     // be deferred until this token is parsed. Will be noPendingToken if there
     // are no csp tokens.
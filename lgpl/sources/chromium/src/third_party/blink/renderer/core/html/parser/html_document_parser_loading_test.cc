@@ -6,9 +6,12 @@
 
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/dom/document_parser_timing.h"
+#include "third_party/blink/renderer/core/dom/node_list.h"
 #include "third_party/blink/renderer/core/testing/sim/sim_request.h"
 #include "third_party/blink/renderer/core/testing/sim/sim_test.h"
 #include "third_party/blink/renderer/platform/testing/histogram_tester.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
 #include "third_party/blink/renderer/platform/testing/unit_test_helpers.h"
 
 namespace blink {
@@ -450,6 +453,108 @@ TEST_F(HTMLDocumentParserSimTest, RewindDifferentNamespace) {
   histogram_.ExpectTotalCount("Parser.DiscardedTokenCount", 1);
 }
 
+TEST_P(HTMLDocumentParserLoadingTest, DetachedSubtreeConstruction) {
+  ScopedParserDetachedSubtreeConstructionForTest detached_construction(true);
+  SimRequest main_resource("https://example.com/test.html", "text/html");
+  LoadURL("https://example.com/test.html");
+
+  main_resource.Start();
+  main_resource.Write("<!DOCTYPE html><body><div id=outer>");
+  test::RunPendingTasks();
+  main_resource.Write("<p>one <b>two</b> three</p><ul><li>a<li>b</ul>");
+  test::RunPendingTasks();
+  // The stray text inside the table row is foster parented, which has to see
+  // the subtrees built so far attached to the document.
+  main_resource.Write("<table><tr><td>cell</td>stray</table></div>");
+  test::RunPendingTasks();
+  main_resource.Finish();
+  test::RunPendingTasks();
+
+  Element* outer = GetDocument().getElementById("outer");
+  ASSERT_TRUE(outer);
+  EXPECT_EQ(
+      "<p>one <b>two</b> three</p><ul><li>a</li><li>b</li></ul>stray"
+      "<table><tbody><tr><td>cell</td></tr></tbody></table>",
+      outer->InnerHTMLAsString());
+}
+
+TEST_P(HTMLDocumentParserLoadingTest,
+       DetachedSubtreeConstructionWithCustomElement) {
+  ScopedParserDetachedSubtreeConstructionForTest detached_construction(true);
+  SimRequest main_resource("https://example.com/test.html", "text/html");
+  LoadURL("https://example.com/test.html");
+
+  main_resource.Start();
+  main_resource.Write(
+      "<!DOCTYPE html><body><div id=log></div><script>"
+      "customElements.define('x-foo', class extends HTMLElement {"
+      "  constructor() {"
+      "    super();"
+      "    document.getElementById('log').textContent ="
+      "        document.getElementById('outer').childNodes.length;"
+      "  }"
+      "});"
+      "</script><div id=outer>");
+  test::RunPendingTasks();
+  // The constructor has to see the paragraphs parsed before the element.
+  main_resource.Write("<p>one</p><p>two</p><x-foo></x-foo></div>");
+  test::RunPendingTasks();
+  main_resource.Finish();
+  test::RunPendingTasks();
+
+  Element* log = GetDocument().getElementById("log");
+  ASSERT_TRUE(log);
+  EXPECT_EQ("2", log->textContent());
+}
+
+TEST_P(HTMLDocumentParserLoadingTest, DetachedSubtreesAppendedInOneBatch) {
+  ScopedParserDetachedSubtreeConstructionForTest detached_construction(true);
+  SimRequest main_resource("https://example.com/test.html", "text/html");
+  LoadURL("https://example.com/test.html");
+
+  main_resource.Start();
+  main_resource.Write("<!DOCTYPE html><body><div id=outer>start");
+  test::RunPendingTasks();
+
+  Element* outer = GetDocument().getElementById("outer");
+  ASSERT_TRUE(outer);
+  // Caches the child node list, which the batch has to invalidate.
+  NodeList* child_nodes = outer->childNodes();
+  EXPECT_EQ(1u, child_nodes->length());
+
+  main_resource.Write(" text<p>one</p><!--c--><p>two</p>end</div>");
+  test::RunPendingTasks();
+  main_resource.Finish();
+  test::RunPendingTasks();
+
+  EXPECT_EQ("start text<p>one</p><!--c--><p>two</p>end",
+            outer->InnerHTMLAsString());
+  ASSERT_EQ(5u, child_nodes->length());
+  EXPECT_EQ(outer->firstChild(), child_nodes->item(0));
+  EXPECT_EQ(outer->lastChild(), child_nodes->item(4));
+}
+
+TEST_F(HTMLDocumentParserSimTest, RecordsParserPumps) {
+  ScopedParserDeadlineSchedulingForTest deadline_scheduling(true);
+  SimRequest main_resource("https://example.com/test.html", "text/html");
+  LoadURL("https://example.com/test.html");
+
+  main_resource.Start();
+  main_resource.Write("<!DOCTYPE html><p>one</p>");
+  test::RunPendingTasks();
+  main_resource.Write("<p>two</p><p>three</p>");
+  test::RunPendingTasks();
+  main_resource.Finish();
+  test::RunPendingTasks();
+
+  const DocumentParserTiming& timing =
+      DocumentParserTiming::From(GetDocument());
+  EXPECT_GE(timing.ParserPumpCount(), 1u);
+  EXPECT_LE(timing.ParserPumpYieldCount(), timing.ParserPumpCount());
+  EXPECT_GE(timing.ParserPumpTokenCount(), 10u);
+  EXPECT_LE(timing.LongestParserPumpDuration(), timing.ParserPumpDuration());
+}
+
 TEST_F(HTMLDocumentParserSimTest, NoRewindSaneDocWrite1) {
   SimRequest main_resource("https://example.com/test.html", "text/html");
   LoadURL("https://example.com/test.html");
@@ -30,6 +30,7 @@
 #include "third_party/blink/renderer/core/html/forms/html_form_control_element.h"
 #include "third_party/blink/renderer/core/html/forms/html_select_element.h"
 #include "third_party/blink/renderer/core/html/html_element.h"
+#include "third_party/blink/renderer/core/html/parser/html_construction_site.h"
 #include "third_party/blink/renderer/core/html_names.h"
 #include "third_party/blink/renderer/core/mathml_names.h"
 #include "third_party/blink/renderer/core/svg_names.h"
@@ -167,7 +168,7 @@ void HTMLElementStack::PopAll() {
     Node& node = *TopNode();
     auto* element = DynamicTo<Element>(node);
     if (element) {
-      element->FinishParsingChildren();
+      FinishParsingChildren(element);
       if (auto* select = DynamicTo<HTMLSelectElement>(node))
         select->SetBlocksFormSubmission(true);
     }
@@ -500,12 +501,18 @@ void HTMLElementStack::PopCommon() {
   DCHECK(!TopStackItem()->HasTagName(kHTMLTag));
   DCHECK(!TopStackItem()->HasTagName(kHeadTag) || !head_element_);
   DCHECK(!TopStackItem()->HasTagName(kBodyTag) || !body_element_);
-  Top()->FinishParsingChildren();
+  FinishParsingChildren(Top());
   top_ = top_->ReleaseNext();
 
   stack_depth_--;
 }
 
+void HTMLElementStack::FinishParsingChildren(Element* element) {
+  if (deferred_attachment_site_ && element->isConnected())
+    deferred_attachment_site_->AttachDeferredSubtrees();
+  element->FinishParsingChildren();
+}
+
 void HTMLElementStack::RemoveNonTopCommon(Element* element) {
   DCHECK(!IsA<HTMLHtmlElement>(element));
   DCHECK(!IsA<HTMLBodyElement>(element));
@@ -514,7 +521,7 @@ void HTMLElementStack::RemoveNonTopCommon(Element* element) {
     if (pos->Next()->GetElement() == element) {
       // FIXME: Is it OK to call finishParsingChildren()
       // when the children aren't actually finished?
-      element->FinishParsingChildren();
+      FinishParsingChildren(element);
       pos->SetNext(pos->Next()->ReleaseNext());
       stack_depth_--;
       return;
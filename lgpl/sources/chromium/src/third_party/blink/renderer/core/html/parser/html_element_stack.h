@@ -36,6 +36,7 @@ namespace blink {
 
 class ContainerNode;
 class Element;
+class HTMLConstructionSite;
 class QualifiedName;
 
 // NOTE: The HTML5 spec uses a backwards (grows downward) stack.  We're using
@@ -165,6 +166,13 @@ class HTMLElementStack {
 
   ContainerNode* RootNode() const;
 
+  // While set, |construction_site| is holding back insertions into the
+  // connected tree, which have to be made before a connected element
+  // finishes parsing its children.
+  void SetDeferredAttachmentSite(HTMLConstructionSite* construction_site) {
+    deferred_attachment_site_ = construction_site;
+  }
+
   void Trace(Visitor*);
 
 #ifndef NDEBUG
@@ -176,6 +184,7 @@ class HTMLElementStack {
   void PushRootNodeCommon(HTMLStackItem*);
   void PopCommon();
   void RemoveNonTopCommon(Element*);
+  void FinishParsingChildren(Element*);
 
   Member<ElementRecord> top_;
 
@@ -189,6 +198,9 @@ class HTMLElementStack {
   Member<Element> body_element_;
   unsigned stack_depth_;
 
+  // Not traced; this is the HTMLConstructionSite that owns the stack.
+  HTMLConstructionSite* deferred_attachment_site_ = nullptr;
+
   DISALLOW_COPY_AND_ASSIGN(HTMLElementStack);
 };
 
@@ -417,6 +417,14 @@ bool ThreadSafeMatch(const String& local_name, const QualifiedName& q_name) {
   return ThreadSafeEqual(local_name.Impl(), q_name.LocalName().Impl());
 }
 
+bool ThreadSafeMatch(const StringView& local_name,
+                     const QualifiedName& q_name) {
+  const StringImpl* impl = q_name.LocalName().Impl();
+  if (local_name.Is8Bit())
+    return Equal(impl, local_name.Characters8(), local_name.length());
+  return Equal(impl, local_name.Characters16(), local_name.length());
+}
+
 template <typename CharType>
 inline StringImpl* FindStringIfStatic(const CharType* characters,
                                       unsigned length) {
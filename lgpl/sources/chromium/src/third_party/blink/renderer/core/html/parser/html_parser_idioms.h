@@ -123,6 +123,7 @@ inline bool IsNotHTMLSpace(CharType character) {
 
 bool ThreadSafeMatch(const QualifiedName&, const QualifiedName&);
 bool ThreadSafeMatch(const String&, const QualifiedName&);
+bool ThreadSafeMatch(const StringView&, const QualifiedName&);
 
 enum CharacterWidth { kLikely8Bit, kForce8Bit, kForce16Bit };
 
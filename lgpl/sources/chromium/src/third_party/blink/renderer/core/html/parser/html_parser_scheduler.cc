@@ -27,8 +27,10 @@
 
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/dom/document_parser_timing.h"
 #include "third_party/blink/renderer/core/frame/local_frame_view.h"
 #include "third_party/blink/renderer/core/html/parser/html_document_parser.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 #include "third_party/blink/renderer/platform/scheduler/public/thread.h"
 #include "third_party/blink/renderer/platform/scheduler/public/thread_scheduler.h"
 
@@ -95,9 +97,35 @@ void HTMLParserScheduler::Detach() {
   is_paused_with_active_timer_ = false;
 }
 
+bool HTMLParserScheduler::ShouldYieldForFrameDeadline(
+    const SpeculationsPumpSession& session,
+    size_t next_chunk_token_count) const {
+  // Always do some work per session, so that a frame that is overdue or
+  // throttled does not split parsing into one task per chunk.
+  const base::TimeDelta kMinimumPumpDuration =
+      base::TimeDelta::FromMilliseconds(4);
+  if (session.ElapsedTime() < kMinimumPumpDuration)
+    return false;
+
+  ThreadScheduler* scheduler = ThreadScheduler::Current();
+  base::TimeTicks frame_begin = scheduler->EstimatedNextFrameBegin();
+  base::TimeTicks now = base::TimeTicks::Now();
+  // Without an upcoming frame to size the session by, only yield to a frame
+  // that is already due.
+  if (frame_begin <= now)
+    return scheduler->IsBeginMainFrameScheduled();
+
+  if (!tokens_per_ms_)
+    return false;
+  base::TimeDelta expected_duration = base::TimeDelta::FromMillisecondsD(
+      next_chunk_token_count / tokens_per_ms_);
+  return now + expected_duration > frame_begin;
+}
+
 inline bool HTMLParserScheduler::ShouldYield(
     const SpeculationsPumpSession& session,
-    bool starting_script) const {
+    bool starting_script,
+    size_t next_chunk_token_count) const {
   if (ThreadScheduler::Current()->ShouldYieldForHighPriorityWork())
     return true;
 
@@ -106,6 +134,10 @@ inline bool HTMLParserScheduler::ShouldYield(
   if (session.ElapsedTime() > kParserTimeLimit)
     return true;
 
+  if (RuntimeEnabledFeatures::ParserDeadlineSchedulingEnabled() &&
+      ShouldYieldForFrameDeadline(session, next_chunk_token_count))
+    return true;
+
   // Yield if a lot of DOM work has been done in this session and a script tag
   // is about to be parsed. This significantly improves render performance for
   // documents that place their scripts at the bottom of the page. Yielding too
@@ -122,8 +154,9 @@ inline bool HTMLParserScheduler::ShouldYield(
 }
 
 bool HTMLParserScheduler::YieldIfNeeded(const SpeculationsPumpSession& session,
-                                        bool starting_script) {
-  if (ShouldYield(session, starting_script)) {
+                                        bool starting_script,
+                                        size_t next_chunk_token_count) {
+  if (ShouldYield(session, starting_script, next_chunk_token_count)) {
     ScheduleForUnpause();
     return true;
   }
@@ -131,6 +164,21 @@ bool HTMLParserScheduler::YieldIfNeeded(const SpeculationsPumpSession& session,
   return false;
 }
 
+void HTMLParserScheduler::DidPumpSpeculations(
+    const SpeculationsPumpSession& session) {
+  base::TimeDelta elapsed = session.ElapsedTime();
+  size_t token_count = session.ProcessedTokens();
+  if (token_count && !elapsed.is_zero()) {
+    double tokens_per_ms = token_count / elapsed.InMillisecondsF();
+    // Weight the latest session by a quarter, so that a single slow one (e.g.
+    // one that ran a long script) does not shrink the next sessions much.
+    tokens_per_ms_ = tokens_per_ms_ ? (3 * tokens_per_ms_ + tokens_per_ms) / 4
+                                    : tokens_per_ms;
+  }
+  DocumentParserTiming::From(*parser_->GetDocument())
+      .RecordParserPump(elapsed, token_count, IsScheduledForUnpause());
+}
+
 void HTMLParserScheduler::ForceUnpauseAfterYield() {
   DCHECK(!cancellable_continue_parse_task_handle_.IsActive());
   is_paused_with_active_timer_ = true;
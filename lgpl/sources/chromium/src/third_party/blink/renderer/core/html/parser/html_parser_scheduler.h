@@ -48,10 +48,13 @@ class SpeculationsPumpSession : public NestingLevelIncrementer {
   base::TimeDelta ElapsedTime() const;
   void AddedElementTokens(size_t count);
   size_t ProcessedElementTokens() const { return processed_element_tokens_; }
+  void AddedTokens(size_t count) { processed_tokens_ += count; }
+  size_t ProcessedTokens() const { return processed_tokens_; }
 
  private:
   base::ElapsedTimer start_time_;
   size_t processed_element_tokens_;
+  size_t processed_tokens_ = 0;
 };
 
 class HTMLParserScheduler final : public GarbageCollected<HTMLParserScheduler> {
@@ -62,7 +65,15 @@ class HTMLParserScheduler final : public GarbageCollected<HTMLParserScheduler> {
 
   bool IsScheduledForUnpause() const;
   void ScheduleForUnpause();
-  bool YieldIfNeeded(const SpeculationsPumpSession&, bool starting_script);
+  // |next_chunk_token_count| is the size of the chunk that would be processed
+  // next if the parser did not yield.
+  bool YieldIfNeeded(const SpeculationsPumpSession&,
+                     bool starting_script,
+                     size_t next_chunk_token_count);
+
+  // Called when a speculations pump session ends, to update the measured
+  // token throughput and report the pump to DocumentParserTiming.
+  void DidPumpSpeculations(const SpeculationsPumpSession&);
 
   /**
    * Can only be called if this scheduler is paused. If this is called,
@@ -81,7 +92,11 @@ class HTMLParserScheduler final : public GarbageCollected<HTMLParserScheduler> {
   void Trace(Visitor*);
 
  private:
-  bool ShouldYield(const SpeculationsPumpSession&, bool starting_script) const;
+  bool ShouldYield(const SpeculationsPumpSession&,
+                   bool starting_script,
+                   size_t next_chunk_token_count) const;
+  bool ShouldYieldForFrameDeadline(const SpeculationsPumpSession&,
+                                   size_t next_chunk_token_count) const;
   void ContinueParsing();
 
   Member<HTMLDocumentParser> parser_;
@@ -90,6 +105,10 @@ class HTMLParserScheduler final : public GarbageCollected<HTMLParserScheduler> {
   TaskHandle cancellable_continue_parse_task_handle_;
   bool is_paused_with_active_timer_;
 
+  // Moving average of the tokens processed per millisecond by previous pump
+  // sessions, or zero before the first one.
+  double tokens_per_ms_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(HTMLParserScheduler);
 };
 
@@ -0,0 +1,204 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/html/parser/html_parser_scheduler.h"
+
+#include <memory>
+#include "base/time/time_override.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/core/html/html_document.h"
+#include "third_party/blink/renderer/core/html/parser/html_document_parser.h"
+#include "third_party/blink/renderer/core/testing/page_test_base.h"
+#include "third_party/blink/renderer/platform/scheduler/public/thread_scheduler.h"
+#include "third_party/blink/renderer/platform/scheduler/test/fake_task_runner.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
+#include "third_party/blink/renderer/platform/testing/scoped_scheduler_overrider.h"
+
+namespace blink {
+
+namespace {
+
+class MockFrameScheduler final : public ThreadScheduler {
+ public:
+  MockFrameScheduler() = default;
+  ~MockFrameScheduler() override = default;
+
+  void SetNextFrame(base::TimeTicks next_frame_begin,
+                    bool begin_main_frame_scheduled) {
+    next_frame_begin_ = next_frame_begin;
+    begin_main_frame_scheduled_ = begin_main_frame_scheduled;
+  }
+
+  // ThreadScheduler implementation:
+  bool IsBeginMainFrameScheduled() const override {
+    return begin_main_frame_scheduled_;
+  }
+  base::TimeTicks EstimatedNextFrameBegin() const override {
+    return next_frame_begin_;
+  }
+  scoped_refptr<base::SingleThreadTaskRunner> V8TaskRunner() override {
+    return nullptr;
+  }
+  void Shutdown() override {}
+  bool ShouldYieldForHighPriorityWork() override { return false; }
+  bool CanExceedIdleDeadlineIfRequired() const override { return false; }
+  void PostIdleTask(const base::Location&, Thread::IdleTask) override {}
+  void PostDelayedIdleTask(const base::Location&,
+                           base::TimeDelta,
+                           Thread::IdleTask) override {}
+  void PostNonNestableIdleTask(const base::Location&,
+                               Thread::IdleTask) override {}
+  std::unique_ptr<PageScheduler> CreatePageScheduler(
+      PageScheduler::Delegate*) override {
+    return nullptr;
+  }
+  scoped_refptr<base::SingleThreadTaskRunner> CompositorTaskRunner() override {
+    return nullptr;
+  }
+  scoped_refptr<base::SingleThreadTaskRunner> IPCTaskRunner() override {
+    return nullptr;
+  }
+  scoped_refptr<base::SingleThreadTaskRunner> DeprecatedDefaultTaskRunner()
+      override {
+    return nullptr;
+  }
+  std::unique_ptr<RendererPauseHandle> PauseScheduler() override {
+    return nullptr;
+  }
+  base::TimeTicks MonotonicallyIncreasingVirtualTime() override {
+    return base::TimeTicks::Now();
+  }
+  void AddTaskObserver(base::TaskObserver*) override {}
+  void RemoveTaskObserver(base::TaskObserver*) override {}
+  void AddRAILModeObserver(RAILModeObserver*) override {}
+  void RemoveRAILModeObserver(RAILModeObserver const*) override {}
+  scheduler::NonMainThreadSchedulerImpl* AsNonMainThreadScheduler() override {
+    return nullptr;
+  }
+  void SetV8Isolate(v8::Isolate* isolate) override {}
+
+ private:
+  base::TimeTicks next_frame_begin_;
+  bool begin_main_frame_scheduled_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(MockFrameScheduler);
+};
+
+}  // namespace
+
+class HTMLParserSchedulerTest : public PageTestBase {
+ protected:
+  void SetUp() override {
+    PageTestBase::SetUp();
+    auto* parser = MakeGarbageCollected<HTMLDocumentParser>(
+        ToHTMLDocument(GetDocument()), kForceSynchronousParsing);
+    scheduler_ = MakeGarbageCollected<HTMLParserScheduler>(
+        parser, base::MakeRefCounted<scheduler::FakeTaskRunner>());
+    now_ticks_ = base::TimeTicks() + base::TimeDelta::FromSeconds(1);
+    time_overrides_ = std::make_unique<base::subtle::ScopedTimeClockOverrides>(
+        nullptr, &HTMLParserSchedulerTest::Now, nullptr);
+    scheduler_overrider_ =
+        std::make_unique<ScopedSchedulerOverrider>(&frame_scheduler_);
+  }
+
+  void TearDown() override {
+    scheduler_overrider_.reset();
+    time_overrides_.reset();
+    scheduler_->Detach();
+    PageTestBase::TearDown();
+  }
+
+  static base::TimeTicks Now() { return now_ticks_; }
+
+  static void AdvanceClock(base::TimeDelta time_delta) {
+    now_ticks_ += time_delta;
+  }
+
+  // Returns whether the scheduler yields before a chunk of |token_count|
+  // tokens, after |session| ran for |elapsed|.
+  bool YieldsAfter(base::TimeDelta elapsed,
+                   const SpeculationsPumpSession& session,
+                   size_t token_count) {
+    AdvanceClock(elapsed);
+    bool yielded = scheduler_->YieldIfNeeded(session, false, token_count);
+    scheduler_->Detach();
+    return yielded;
+  }
+
+  // Runs a pump session of |token_count| tokens over |elapsed|, from which the
+  // scheduler measures the token throughput.
+  void PumpTokens(size_t token_count, base::TimeDelta elapsed) {
+    SpeculationsPumpSession session(nesting_level_);
+    session.AddedTokens(token_count);
+    AdvanceClock(elapsed);
+    scheduler_->DidPumpSpeculations(session);
+  }
+
+  static base::TimeTicks now_ticks_;
+  MockFrameScheduler frame_scheduler_;
+  Persistent<HTMLParserScheduler> scheduler_;
+  unsigned nesting_level_ = 0;
+
+ private:
+  std::unique_ptr<base::subtle::ScopedTimeClockOverrides> time_overrides_;
+  std::unique_ptr<ScopedSchedulerOverrider> scheduler_overrider_;
+};
+
+// static
+base::TimeTicks HTMLParserSchedulerTest::now_ticks_;
+
+TEST_F(HTMLParserSchedulerTest, YieldsToDueFrameAfterMinimumDuration) {
+  ScopedParserDeadlineSchedulingForTest deadline_scheduling(true);
+  frame_scheduler_.SetNextFrame(base::TimeTicks(), true);
+
+  SpeculationsPumpSession session(nesting_level_);
+  // Every session runs for at least 4ms, even if a frame is due.
+  EXPECT_FALSE(YieldsAfter(base::TimeDelta::FromMilliseconds(3), session, 1));
+  EXPECT_TRUE(YieldsAfter(base::TimeDelta::FromMilliseconds(2), session, 1));
+}
+
+TEST_F(HTMLParserSchedulerTest, DoesNotYieldWithoutFrame) {
+  ScopedParserDeadlineSchedulingForTest deadline_scheduling(true);
+  PumpTokens(100, base::TimeDelta::FromMilliseconds(1));
+  frame_scheduler_.SetNextFrame(base::TimeTicks(), false);
+
+  SpeculationsPumpSession session(nesting_level_);
+  EXPECT_FALSE(
+      YieldsAfter(base::TimeDelta::FromMilliseconds(10), session, 10000));
+}
+
+TEST_F(HTMLParserSchedulerTest, YieldsIfChunkWouldMissFrame) {
+  ScopedParserDeadlineSchedulingForTest deadline_scheduling(true);
+  // 100 tokens per millisecond.
+  PumpTokens(1000, base::TimeDelta::FromMilliseconds(10));
+
+  SpeculationsPumpSession session(nesting_level_);
+  AdvanceClock(base::TimeDelta::FromMilliseconds(5));
+  frame_scheduler_.SetNextFrame(
+      Now() + base::TimeDelta::FromMilliseconds(3), false);
+  // 200 tokens take 2ms, and finish before the frame.
+  EXPECT_FALSE(YieldsAfter(base::TimeDelta(), session, 200));
+  // 400 tokens take 4ms, and would delay the frame.
+  EXPECT_TRUE(YieldsAfter(base::TimeDelta(), session, 400));
+}
+
+TEST_F(HTMLParserSchedulerTest, DoesNotYieldForFrameBeforeThroughputIsKnown) {
+  ScopedParserDeadlineSchedulingForTest deadline_scheduling(true);
+
+  SpeculationsPumpSession session(nesting_level_);
+  AdvanceClock(base::TimeDelta::FromMilliseconds(5));
+  frame_scheduler_.SetNextFrame(
+      Now() + base::TimeDelta::FromMilliseconds(1), false);
+  EXPECT_FALSE(YieldsAfter(base::TimeDelta(), session, 10000));
+}
+
+TEST_F(HTMLParserSchedulerTest, IgnoresFrameDeadlineWhenDisabled) {
+  ScopedParserDeadlineSchedulingForTest deadline_scheduling(false);
+  frame_scheduler_.SetNextFrame(base::TimeTicks(), true);
+
+  SpeculationsPumpSession session(nesting_level_);
+  EXPECT_FALSE(YieldsAfter(base::TimeDelta::FromMilliseconds(10), session, 1));
+}
+
+}  // namespace blink
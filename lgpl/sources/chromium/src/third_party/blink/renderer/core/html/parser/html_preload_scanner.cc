@@ -83,6 +83,10 @@ static bool Match(const String& name, const QualifiedName& q_name) {
   return ThreadSafeMatch(name, q_name);
 }
 
+static bool Match(const StringView& name, const QualifiedName& q_name) {
+  return ThreadSafeMatch(name, q_name);
+}
+
 static const StringImpl* TagImplFor(const HTMLToken::DataVector& data) {
   AtomicString tag_name(data);
   const StringImpl* result = tag_name.Impl();
@@ -190,7 +194,7 @@ class TokenPreloadScanner::StartTagScanner {
     if (!tag_impl_)
       return;
     for (const CompactHTMLToken::Attribute& html_token_attribute : attributes)
-      ProcessAttribute(html_token_attribute.GetName(),
+      ProcessAttribute(html_token_attribute.NameView(),
                        html_token_attribute.Value());
     PostProcessAfterAttributes();
   }
@@ -127,6 +127,10 @@ class HTMLToken {
     String Value() const { return String(value_); }
 
     void AppendToValue(UChar c) { value_.push_back(c); }
+    template <typename CharType>
+    void AppendToValue(const CharType* characters, wtf_size_t length) {
+      value_.Append(characters, length);
+    }
     void AppendToValue(const String& value) { value.AppendTo(value_); }
     void ClearValue() { value_.clear(); }
 
@@ -359,6 +363,13 @@ class HTMLToken {
     current_attribute_->AppendToValue(character);
   }
 
+  template <typename CharType>
+  void AppendToAttributeValue(const CharType* characters, wtf_size_t length) {
+    DCHECK(type_ == kStartTag || type_ == kEndTag);
+    current_attribute_->ValueRange().CheckValidStart();
+    current_attribute_->AppendToValue(characters, length);
+  }
+
   void AppendToAttributeValue(wtf_size_t i, const String& value) {
     DCHECK(!value.IsEmpty());
     DCHECK(type_ == kStartTag || type_ == kEndTag);
@@ -408,6 +419,18 @@ class HTMLToken {
     data_.AppendVector(characters);
   }
 
+  void AppendToCharacter(const LChar* characters, wtf_size_t length) {
+    DCHECK_EQ(type_, kCharacter);
+    data_.Append(characters, length);
+  }
+
+  void AppendToCharacter(const UChar* characters, wtf_size_t length) {
+    DCHECK_EQ(type_, kCharacter);
+    data_.Append(characters, length);
+    for (wtf_size_t i = 0; i < length; ++i)
+      or_all_data_ |= characters[i];
+  }
+
   /* Comment Tokens */
 
   const DataVector& Comment() const {
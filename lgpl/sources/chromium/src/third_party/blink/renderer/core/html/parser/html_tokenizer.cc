@@ -27,6 +27,8 @@
 
 #include "third_party/blink/renderer/core/html/parser/html_tokenizer.h"
 
+#include "base/bits.h"
+#include "build/build_config.h"
 #include "third_party/blink/renderer/core/html/parser/html_entity_parser.h"
 #include "third_party/blink/renderer/core/html/parser/html_parser_idioms.h"
 #include "third_party/blink/renderer/core/html/parser/html_tree_builder.h"
@@ -36,6 +38,11 @@
 #include "third_party/blink/renderer/platform/wtf/text/ascii_ctype.h"
 #include "third_party/blink/renderer/platform/wtf/text/unicode.h"
 
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__)
+#include <emmintrin.h>
+#define HTML_TOKENIZER_USE_SSE2 1
+#endif
+
 namespace blink {
 
 using namespace html_names;
@@ -60,6 +67,71 @@ static inline bool VectorEqualsString(const Vector<LChar, 32>& vector,
   return Equal(string.Impl(), vector.data(), vector.size());
 }
 
+// Characters which end a run: the two given by the current state, plus the
+// ones InputStreamPreprocessor rewrites or uses for line numbers.
+static inline bool IsRunDelimiter(UChar cc, char delimiter1, char delimiter2) {
+  return cc == static_cast<UChar>(delimiter1) ||
+         cc == static_cast<UChar>(delimiter2) || cc == '\n' || cc == '\r' ||
+         cc == '\0';
+}
+
+#if defined(HTML_TOKENIZER_USE_SSE2)
+// Returns a bit mask of the delimiters among the 16 characters at
+// |characters|, one bit per character.
+static inline uint32_t DelimiterMask(const LChar* characters,
+                                     char delimiter1,
+                                     char delimiter2) {
+  __m128i chars =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters));
+  __m128i mask = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(delimiter1)),
+                              _mm_cmpeq_epi8(chars, _mm_set1_epi8(delimiter2)));
+  mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, _mm_set1_epi8('\n')));
+  mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, _mm_set1_epi8('\r')));
+  mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, _mm_setzero_si128()));
+  return _mm_movemask_epi8(mask);
+}
+
+// Same for the 8 characters at |characters|, two bits per character.
+static inline uint32_t DelimiterMask(const UChar* characters,
+                                     char delimiter1,
+                                     char delimiter2) {
+  __m128i chars =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters));
+  __m128i mask =
+      _mm_or_si128(_mm_cmpeq_epi16(chars, _mm_set1_epi16(delimiter1)),
+                   _mm_cmpeq_epi16(chars, _mm_set1_epi16(delimiter2)));
+  mask = _mm_or_si128(mask, _mm_cmpeq_epi16(chars, _mm_set1_epi16('\n')));
+  mask = _mm_or_si128(mask, _mm_cmpeq_epi16(chars, _mm_set1_epi16('\r')));
+  mask = _mm_or_si128(mask, _mm_cmpeq_epi16(chars, _mm_setzero_si128()));
+  return _mm_movemask_epi8(mask);
+}
+#endif  // defined(HTML_TOKENIZER_USE_SSE2)
+
+// Returns the index of the first delimiter in |characters|, or |length| if
+// there is none.
+template <typename CharType>
+static wtf_size_t FindRunDelimiter(const CharType* characters,
+                                   wtf_size_t length,
+                                   char delimiter1,
+                                   char delimiter2) {
+  wtf_size_t index = 0;
+#if defined(HTML_TOKENIZER_USE_SSE2)
+  constexpr wtf_size_t kStride = sizeof(__m128i) / sizeof(CharType);
+  while (length - index >= kStride) {
+    uint32_t mask = DelimiterMask(characters + index, delimiter1, delimiter2);
+    if (mask) {
+      return index +
+             base::bits::CountTrailingZeroBits(mask) / sizeof(CharType);
+    }
+    index += kStride;
+  }
+#endif  // defined(HTML_TOKENIZER_USE_SSE2)
+  while (index < length &&
+         !IsRunDelimiter(characters[index], delimiter1, delimiter2))
+    ++index;
+  return index;
+}
+
 #define HTML_BEGIN_STATE(stateName) BEGIN_STATE(HTMLTokenizer, stateName)
 #define HTML_RECONSUME_IN(stateName) RECONSUME_IN(HTMLTokenizer, stateName)
 #define HTML_ADVANCE_TO(stateName) ADVANCE_TO(HTMLTokenizer, stateName)
@@ -98,6 +170,57 @@ inline bool HTMLTokenizer::ProcessEntity(SegmentedString& source) {
   return true;
 }
 
+inline wtf_size_t HTMLTokenizer::RunLength(SegmentedString& source,
+                                           UChar cc,
+                                           char delimiter1,
+                                           char delimiter2) {
+  if (source.CurrentChar() != cc)
+    return 0;
+  if (source.CurrentSubstringIs8Bit()) {
+    return FindRunDelimiter(source.CurrentSubstringCharacters8(),
+                            source.CurrentSubstringLength(), delimiter1,
+                            delimiter2);
+  }
+  return FindRunDelimiter(source.CurrentSubstringCharacters16(),
+                          source.CurrentSubstringLength(), delimiter1,
+                          delimiter2);
+}
+
+inline void HTMLTokenizer::BufferCharacterRun(SegmentedString& source,
+                                              UChar cc,
+                                              char delimiter1,
+                                              char delimiter2) {
+  wtf_size_t length = RunLength(source, cc, delimiter1, delimiter2);
+  if (length <= 1) {
+    BufferCharacter(cc);
+    return;
+  }
+  token_->EnsureIsCharacterToken();
+  if (source.CurrentSubstringIs8Bit())
+    token_->AppendToCharacter(source.CurrentSubstringCharacters8(), length);
+  else
+    token_->AppendToCharacter(source.CurrentSubstringCharacters16(), length);
+  source.AdvancePastNonNewlinesInCurrentSubstring(length - 1);
+}
+
+inline void HTMLTokenizer::AppendToAttributeValueRun(SegmentedString& source,
+                                                     UChar cc,
+                                                     char delimiter) {
+  wtf_size_t length = RunLength(source, cc, delimiter, '&');
+  if (length <= 1) {
+    token_->AppendToAttributeValue(cc);
+    return;
+  }
+  if (source.CurrentSubstringIs8Bit()) {
+    token_->AppendToAttributeValue(source.CurrentSubstringCharacters8(),
+                                   length);
+  } else {
+    token_->AppendToAttributeValue(source.CurrentSubstringCharacters16(),
+                                   length);
+  }
+  source.AdvancePastNonNewlinesInCurrentSubstring(length - 1);
+}
+
 bool HTMLTokenizer::FlushBufferedEndTag(SegmentedString& source) {
   DCHECK(token_->GetType() == HTMLToken::kCharacter ||
          token_->GetType() == HTMLToken::kUninitialized);
@@ -168,7 +291,7 @@ bool HTMLTokenizer::NextToken(SegmentedString& source, HTMLToken& token) {
       } else if (cc == kEndOfFileMarker)
         return EmitEndOfFile(source);
       else {
-        BufferCharacter(cc);
+        BufferCharacterRun(source, cc, '<', '&');
         HTML_CONSUME(kDataState);
       }
     }
@@ -189,7 +312,7 @@ bool HTMLTokenizer::NextToken(SegmentedString& source, HTMLToken& token) {
       else if (cc == kEndOfFileMarker)
         return EmitEndOfFile(source);
       else {
-        BufferCharacter(cc);
+        BufferCharacterRun(source, cc, '<', '&');
         HTML_CONSUME(kRCDATAState);
       }
     }
@@ -208,7 +331,7 @@ bool HTMLTokenizer::NextToken(SegmentedString& source, HTMLToken& token) {
       else if (cc == kEndOfFileMarker)
         return EmitEndOfFile(source);
       else {
-        BufferCharacter(cc);
+        BufferCharacterRun(source, cc, '<', '<');
         HTML_CONSUME(kRAWTEXTState);
       }
     }
@@ -220,7 +343,7 @@ bool HTMLTokenizer::NextToken(SegmentedString& source, HTMLToken& token) {
       else if (cc == kEndOfFileMarker)
         return EmitEndOfFile(source);
       else {
-        BufferCharacter(cc);
+        BufferCharacterRun(source, cc, '<', '<');
         HTML_CONSUME(kScriptDataState);
       }
     }
@@ -229,7 +352,7 @@ bool HTMLTokenizer::NextToken(SegmentedString& source, HTMLToken& token) {
     HTML_BEGIN_STATE(kPLAINTEXTState) {
       if (cc == kEndOfFileMarker)
         return EmitEndOfFile(source);
-      BufferCharacter(cc);
+      BufferCharacterRun(source, cc, '\0', '\0');
       HTML_CONSUME(kPLAINTEXTState);
     }
     END_STATE()
@@ -806,7 +929,7 @@ bool HTMLTokenizer::NextToken(SegmentedString& source, HTMLToken& token) {
         token_->EndAttributeValue(source.NumberOfCharactersConsumed());
         HTML_RECONSUME_IN(kDataState);
       } else {
-        token_->AppendToAttributeValue(cc);
+        AppendToAttributeValueRun(source, cc, '"');
         HTML_CONSUME(kAttributeValueDoubleQuotedState);
       }
     }
@@ -824,7 +947,7 @@ bool HTMLTokenizer::NextToken(SegmentedString& source, HTMLToken& token) {
         token_->EndAttributeValue(source.NumberOfCharactersConsumed());
         HTML_RECONSUME_IN(kDataState);
       } else {
-        token_->AppendToAttributeValue(cc);
+        AppendToAttributeValueRun(source, cc, '\'');
         HTML_CONSUME(kAttributeValueSingleQuotedState);
       }
     }
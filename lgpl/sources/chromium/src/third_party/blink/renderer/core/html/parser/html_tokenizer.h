@@ -205,6 +205,27 @@ class CORE_EXPORT HTMLTokenizer {
     token_->AppendToCharacter(character);
   }
 
+  // Returns the length of the run of characters in the current substring of
+  // |source| that starts with the current character |cc| and ends before the
+  // first |delimiter1|, |delimiter2| or character that
+  // InputStreamPreprocessor needs to see. Returns 0 if the preprocessor has
+  // already replaced |cc|.
+  inline wtf_size_t RunLength(SegmentedString& source,
+                              UChar cc,
+                              char delimiter1,
+                              char delimiter2);
+
+  // These append a whole run to the token at once, instead of one character
+  // per pass through the state machine. The last character of the run is
+  // left current, for the caller to consume as usual.
+  inline void BufferCharacterRun(SegmentedString&,
+                                 UChar cc,
+                                 char delimiter1,
+                                 char delimiter2);
+  inline void AppendToAttributeValueRun(SegmentedString&,
+                                        UChar cc,
+                                        char delimiter);
+
   inline bool EmitAndResumeIn(SegmentedString& source, State state) {
     SaveEndTagNameIfNeeded();
     state_ = state;
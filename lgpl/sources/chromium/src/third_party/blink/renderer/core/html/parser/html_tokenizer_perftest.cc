@@ -0,0 +1,79 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/html/parser/html_tokenizer.h"
+
+#include <memory>
+
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/core/html/parser/html_parser_options.h"
+#include "third_party/blink/renderer/core/html/parser/html_token.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
+
+namespace blink {
+
+namespace {
+
+// Roughly mimics the shape of a large server-rendered page: nested elements
+// with long class and data attributes, paragraphs of text and indentation.
+String BuildDocument(unsigned item_count) {
+  StringBuilder builder;
+  builder.Append("<!DOCTYPE html>\n<html>\n<body>\n");
+  for (unsigned i = 0; i < item_count; ++i) {
+    builder.Append("  <div class=\"result-list__item result-list__item--");
+    builder.AppendNumber(i);
+    builder.Append(
+        "\" data-tracking-payload='{\"source\":\"search\",\"rank\":");
+    builder.AppendNumber(i);
+    builder.Append(
+        "}'>\n"
+        "    <a href=\"/products/some-rather-long-product-slug?ref=search\">"
+        "Product title that goes on for a while</a>\n"
+        "    <p>Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed "
+        "do eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut "
+        "enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi "
+        "ut aliquip ex ea commodo consequat &amp; more.</p>\n"
+        "  </div>\n");
+  }
+  builder.Append("</body>\n</html>\n");
+  return builder.ToString();
+}
+
+}  // namespace
+
+TEST(HTMLTokenizerPerfTest, LargeDocument) {
+  const unsigned kIterationCount = 20;
+  const String document_text = BuildDocument(10000);
+  ASSERT_TRUE(document_text.Is8Bit());
+
+  size_t token_count = 0;
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (unsigned count = 0; count < kIterationCount; count++) {
+    HTMLParserOptions options;
+    std::unique_ptr<HTMLTokenizer> tokenizer =
+        std::make_unique<HTMLTokenizer>(options);
+    SegmentedString input(document_text);
+    input.Close();
+    HTMLToken token;
+    while (tokenizer->NextToken(input, token)) {
+      ++token_count;
+      if (token.GetType() == HTMLToken::kEndOfFile)
+        break;
+      token.Clear();
+    }
+  }
+  base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+  LOG(ERROR) << "  Time to tokenize " << document_text.length() << " bytes "
+             << kIterationCount << " times: " << elapsed.InMilliseconds()
+             << "ms";
+  LOG(ERROR) << "    Tokens per second: "
+             << static_cast<int64_t>(token_count / elapsed.InSecondsF());
+  LOG(ERROR) << "    Megabytes per second: "
+             << document_text.length() * kIterationCount /
+                    elapsed.InSecondsF() / (1024 * 1024);
+}
+
+}  // namespace blink
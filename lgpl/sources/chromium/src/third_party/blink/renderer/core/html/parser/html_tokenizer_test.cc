@@ -7,6 +7,7 @@
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/renderer/core/html/parser/html_parser_options.h"
 #include "third_party/blink/renderer/core/html/parser/html_token.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
 
 #include <memory>
 
@@ -29,4 +30,50 @@ TEST(HTMLTokenizerTest, ZeroOffsetAttributeNameRange) {
   EXPECT_FALSE(tokenizer->NextToken(input2, token));
 }
 
+// Runs of ordinary characters are appended to tokens in bulk; check that runs
+// ending at every position of a SIMD block produce the same tokens, for both
+// 8-bit and 16-bit input.
+TEST(HTMLTokenizerTest, LongCharacterAndAttributeValueRuns) {
+  for (UChar last : {static_cast<UChar>('z'), static_cast<UChar>(0x3042)}) {
+    for (unsigned length = 1; length < 40; ++length) {
+      StringBuilder run_builder;
+      for (unsigned i = 1; i < length; ++i)
+        run_builder.Append(static_cast<LChar>('a' + i % 26));
+      run_builder.Append(last);
+      String run = run_builder.ToString();
+
+      HTMLParserOptions options;
+      std::unique_ptr<HTMLTokenizer> tokenizer =
+          std::make_unique<HTMLTokenizer>(options);
+      HTMLToken token;
+      StringBuilder markup;
+      markup.Append("<p title=\"");
+      markup.Append(run);
+      markup.Append("&amp;");
+      markup.Append(run);
+      markup.Append("\">");
+      markup.Append(run);
+      markup.Append("\r\n");
+      markup.Append(run);
+      // Null characters are dropped in the data state.
+      markup.Append(static_cast<LChar>('\0'));
+      markup.Append(run);
+      markup.Append("<br>");
+      SegmentedString input(markup.ToString());
+
+      EXPECT_TRUE(tokenizer->NextToken(input, token));
+      ASSERT_EQ(HTMLToken::kStartTag, token.GetType());
+      ASSERT_EQ(1u, token.Attributes().size());
+      EXPECT_EQ(run + "&" + run, token.Attributes()[0].Value());
+      token.Clear();
+
+      EXPECT_TRUE(tokenizer->NextToken(input, token));
+      ASSERT_EQ(HTMLToken::kCharacter, token.GetType());
+      EXPECT_EQ(run + "\n" + run + run, String(token.Characters()));
+      EXPECT_EQ(1, input.CurrentLine().ZeroBasedInt());
+      token.Clear();
+    }
+  }
+}
+
 }  // namespace blink
@@ -89,6 +89,11 @@ class HTMLTreeBuilder final : public GarbageCollected<HTMLTreeBuilder> {
   // DOM nodes. Flushing pending text depends on |mode|.
   void Flush(FlushMode mode) { tree_.Flush(mode); }
 
+  // See HTMLConstructionSite::SetDefersSubtreeAttachment().
+  void SetDefersSubtreeAttachment(bool defers) {
+    tree_.SetDefersSubtreeAttachment(defers);
+  }
+
   void SetShouldSkipLeadingNewline(bool should_skip) {
     should_skip_leading_newline_ = should_skip;
   }
@@ -63,8 +63,9 @@ class CORE_EXPORT HTMLTreeBuilderSimulator {
 
   SimulatedToken Simulate(const CompactHTMLToken&, HTMLTokenizer*);
 
- private:
   bool InForeignContent() const { return namespace_stack_.back() != HTML; }
+
+ private:
   bool IsHTMLIntegrationPointForStartTag(const CompactHTMLToken&) const;
   bool IsHTMLIntegrationPointForEndTag(const CompactHTMLToken&) const;
 
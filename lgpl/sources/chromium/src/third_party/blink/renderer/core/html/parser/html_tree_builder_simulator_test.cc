@@ -18,15 +18,16 @@ TEST(HTMLTreeBuilderSimulatorTest, SelfClosingSVGFollowedByScript) {
       std::make_unique<HTMLTokenizer>(options);
   SegmentedString input("<svg/><script></script>");
   HTMLToken token;
+  CompactHTMLTokenArena arena;
   EXPECT_TRUE(tokenizer->NextToken(input, token));
   EXPECT_EQ(HTMLTreeBuilderSimulator::kOtherToken,
-            simulator.Simulate(CompactHTMLToken(&token, TextPosition()),
+            simulator.Simulate(CompactHTMLToken(&token, TextPosition(), arena),
                                tokenizer.get()));
 
   token.Clear();
   EXPECT_TRUE(tokenizer->NextToken(input, token));
   EXPECT_EQ(HTMLTreeBuilderSimulator::kValidScriptStart,
-            simulator.Simulate(CompactHTMLToken(&token, TextPosition()),
+            simulator.Simulate(CompactHTMLToken(&token, TextPosition(), arena),
                                tokenizer.get()));
 
   EXPECT_EQ(HTMLTokenizer::kScriptDataState, tokenizer->GetState());
@@ -34,7 +35,7 @@ TEST(HTMLTreeBuilderSimulatorTest, SelfClosingSVGFollowedByScript) {
   token.Clear();
   EXPECT_TRUE(tokenizer->NextToken(input, token));
   EXPECT_EQ(HTMLTreeBuilderSimulator::kScriptEnd,
-            simulator.Simulate(CompactHTMLToken(&token, TextPosition()),
+            simulator.Simulate(CompactHTMLToken(&token, TextPosition(), arena),
                                tokenizer.get()));
 }
 
@@ -45,15 +46,16 @@ TEST(HTMLTreeBuilderSimulatorTest, SelfClosingMathFollowedByScript) {
       std::make_unique<HTMLTokenizer>(options);
   SegmentedString input("<math/><script></script>");
   HTMLToken token;
+  CompactHTMLTokenArena arena;
   EXPECT_TRUE(tokenizer->NextToken(input, token));
   EXPECT_EQ(HTMLTreeBuilderSimulator::kOtherToken,
-            simulator.Simulate(CompactHTMLToken(&token, TextPosition()),
+            simulator.Simulate(CompactHTMLToken(&token, TextPosition(), arena),
                                tokenizer.get()));
 
   token.Clear();
   EXPECT_TRUE(tokenizer->NextToken(input, token));
   EXPECT_EQ(HTMLTreeBuilderSimulator::kValidScriptStart,
-            simulator.Simulate(CompactHTMLToken(&token, TextPosition()),
+            simulator.Simulate(CompactHTMLToken(&token, TextPosition(), arena),
                                tokenizer.get()));
 
   EXPECT_EQ(HTMLTokenizer::kScriptDataState, tokenizer->GetState());
@@ -61,7 +63,7 @@ TEST(HTMLTreeBuilderSimulatorTest, SelfClosingMathFollowedByScript) {
   token.Clear();
   EXPECT_TRUE(tokenizer->NextToken(input, token));
   EXPECT_EQ(HTMLTreeBuilderSimulator::kScriptEnd,
-            simulator.Simulate(CompactHTMLToken(&token, TextPosition()),
+            simulator.Simulate(CompactHTMLToken(&token, TextPosition(), arena),
                                tokenizer.get()));
 }
 
@@ -72,15 +74,16 @@ TEST(HTMLTreeBuilderSimulatorTest, DetectInvalidScriptType) {
       std::make_unique<HTMLTokenizer>(options);
   SegmentedString input("<script type=\"text/html\"></script>");
   HTMLToken token;
+  CompactHTMLTokenArena arena;
   EXPECT_TRUE(tokenizer->NextToken(input, token));
   EXPECT_NE(HTMLTreeBuilderSimulator::kValidScriptStart,
-            simulator.Simulate(CompactHTMLToken(&token, TextPosition()),
+            simulator.Simulate(CompactHTMLToken(&token, TextPosition(), arena),
                                tokenizer.get()));
 
   token.Clear();
   EXPECT_TRUE(tokenizer->NextToken(input, token));
   EXPECT_EQ(HTMLTreeBuilderSimulator::kScriptEnd,
-            simulator.Simulate(CompactHTMLToken(&token, TextPosition()),
+            simulator.Simulate(CompactHTMLToken(&token, TextPosition(), arena),
                                tokenizer.get()));
 }
 
@@ -307,6 +307,39 @@ TEST_F(GridTest, ExplicitlyPositionedChild) {
   }
 }
 
+// The min-size contribution of an item with a percent min-width resolves
+// against its grid area, so it has to be recomputed as the base sizes of the
+// spanned tracks grow during step 2 of the track sizing algorithm.
+TEST_F(GridTest, PercentMinSizeOfSpanningItem) {
+  SetBodyInnerHTML(R"HTML(
+    <style>
+      .grid {
+        display: grid;
+        width: 1000px;
+        grid-template-columns: max-content max-content;
+        justify-content: start;
+      }
+      #item {
+        grid-column: span 2;
+        min-width: 100%;
+        margin-left: 50px;
+      }
+    </style>
+    <div id=target class=grid>
+      <div id=item><div style="width: 200px"></div></div>
+    </div>
+  )HTML");
+  auto* layout_grid = GetGridByElementId("target");
+  Vector<LayoutUnit> columns =
+      layout_grid->TrackSizesForComputedStyle(kForColumns);
+  ASSERT_EQ(2u, columns.size());
+  // The min-content contribution, 250px, makes both base sizes 125px. The
+  // min-size contribution is then 100% of that plus the margin, 300px, which
+  // raises both growth limits to 150px.
+  EXPECT_EQ(LayoutUnit(150), columns[0]);
+  EXPECT_EQ(LayoutUnit(150), columns[1]);
+}
+
 TEST_F(GridTest, CellInsert) {
   auto track = base::WrapUnique(new ListGrid::GridTrack(0, kForColumns));
   auto* cell = new ListGrid::GridCell(0, 0);
@@ -985,8 +985,11 @@ void GridTrackSizingAlgorithm::InitializeTrackSizes() {
   bool indefinite_height =
       direction_ == kForRows && !layout_grid_->CachedHasDefiniteLogicalHeight();
   size_t num_tracks = track_list.size();
+  track_sizes_.Shrink(0);
+  track_sizes_.ReserveCapacity(num_tracks);
   for (size_t i = 0; i < num_tracks; ++i) {
-    GridTrackSize track_size = GetGridTrackSize(direction_, i);
+    track_sizes_.push_back(GetGridTrackSize(direction_, i));
+    const GridTrackSize& track_size = track_sizes_.back();
     GridTrack& track = track_list[i];
     track.SetBaseSize(InitialBaseSize(track_size));
     track.SetGrowthLimit(InitialGrowthLimit(track_size, track.BaseSize()));
@@ -1014,29 +1017,65 @@ void GridTrackSizingAlgorithm::InitializeTrackSizes() {
   }
 }
 
+// We're basically using a class instead of a std::pair because of accessing
+// gridItem() or getGridSpan() is much more self-explanatory that using .first
+// or .second members in the pair. Having a std::pair<LayoutBox*, size_t>
+// does not work either because we still need the GridSpan so we'd have to add
+// an extra hash lookup for each item.
+class GridItemWithSpan {
+ public:
+  GridItemWithSpan(LayoutBox& grid_item, const GridSpan& grid_span)
+      : grid_item_(&grid_item), grid_span_(grid_span) {}
+
+  LayoutBox& GridItem() const { return *grid_item_; }
+  GridSpan GetGridSpan() const { return grid_span_; }
+
+  base::Optional<LayoutUnit>& CachedContribution(
+      GridItemContributionType type) {
+    DCHECK_NE(type, kMinSizeContribution);
+    return content_contributions_[type - kMinContentContribution];
+  }
+
+  bool operator<(const GridItemWithSpan& other) const {
+    return grid_span_.IntegerSpan() < other.grid_span_.IntegerSpan();
+  }
+
+ private:
+  LayoutBox* grid_item_;
+  GridSpan grid_span_;
+  // The min-content and max-content contributions. Computing them may lay out
+  // the item, and they only depend on the tracks in the other direction, so
+  // they are computed at most once per run.
+  base::Optional<LayoutUnit> content_contributions_[2];
+};
+
 void GridTrackSizingAlgorithm::SizeTrackToFitNonSpanningItem(
-    const GridSpan& span,
-    LayoutBox& grid_item,
+    GridItemWithSpan& grid_item_with_span,
     GridTrack& track) {
-  const size_t track_position = span.StartLine();
-  GridTrackSize track_size = GetGridTrackSize(direction_, track_position);
+  const size_t track_position = grid_item_with_span.GetGridSpan().StartLine();
+  const GridTrackSize& track_size = track_sizes_[track_position];
 
   if (track_size.HasMinContentMinTrackBreadth()) {
-    track.SetBaseSize(
-        std::max(track.BaseSize(), strategy_->MinContentForChild(grid_item)));
+    track.SetBaseSize(std::max(
+        track.BaseSize(),
+        ItemContribution(kMinContentContribution, grid_item_with_span)));
   } else if (track_size.HasMaxContentMinTrackBreadth()) {
-    track.SetBaseSize(
-        std::max(track.BaseSize(), strategy_->MaxContentForChild(grid_item)));
+    track.SetBaseSize(std::max(
+        track.BaseSize(),
+        ItemContribution(kMaxContentContribution, grid_item_with_span)));
   } else if (track_size.HasAutoMinTrackBreadth()) {
-    track.SetBaseSize(
-        std::max(track.BaseSize(), strategy_->MinSizeForChild(grid_item)));
+    track.SetBaseSize(std::max(
+        track.BaseSize(),
+        ItemContribution(kMinSizeContribution, grid_item_with_span)));
   }
 
   if (track_size.HasMinContentMaxTrackBreadth()) {
-    track.SetGrowthLimit(std::max(track.GrowthLimit(),
-                                  strategy_->MinContentForChild(grid_item)));
+    track.SetGrowthLimit(std::max(
+        track.GrowthLimit(),
+        ItemContribution(kMinContentContribution, grid_item_with_span)));
   } else if (track_size.HasMaxContentOrAutoMaxTrackBreadth()) {
-    LayoutUnit growth_limit = strategy_->MaxContentForChild(grid_item);
+    LayoutUnit growth_limit =
+        ItemContribution(kMaxContentContribution, grid_item_with_span);
     if (track_size.IsFitContent()) {
       growth_limit =
           std::min(growth_limit,
@@ -1050,8 +1089,7 @@ void GridTrackSizingAlgorithm::SizeTrackToFitNonSpanningItem(
 bool GridTrackSizingAlgorithm::SpanningItemCrossesFlexibleSizedTracks(
     const GridSpan& span) const {
   for (const auto& track_position : span) {
-    const GridTrackSize& track_size =
-        GetGridTrackSize(direction_, track_position);
+    const GridTrackSize& track_size = track_sizes_[track_position];
     if (track_size.MinTrackBreadth().IsFlex() ||
         track_size.MaxTrackBreadth().IsFlex())
       return true;
@@ -1060,28 +1098,6 @@ bool GridTrackSizingAlgorithm::SpanningItemCrossesFlexibleSizedTracks(
   return false;
 }
 
-// We're basically using a class instead of a std::pair because of accessing
-// gridItem() or getGridSpan() is much more self-explanatory that using .first
-// or .second members in the pair. Having a std::pair<LayoutBox*, size_t>
-// does not work either because we still need the GridSpan so we'd have to add
-// an extra hash lookup for each item.
-class GridItemWithSpan {
- public:
-  GridItemWithSpan(LayoutBox& grid_item, const GridSpan& grid_span)
-      : grid_item_(&grid_item), grid_span_(grid_span) {}
-
-  LayoutBox& GridItem() const { return *grid_item_; }
-  GridSpan GetGridSpan() const { return grid_span_; }
-
-  bool operator<(const GridItemWithSpan other) const {
-    return grid_span_.IntegerSpan() < other.grid_span_.IntegerSpan();
-  }
-
- private:
-  LayoutBox* grid_item_;
-  GridSpan grid_span_;
-};
-
 struct GridItemsSpanGroupRange {
   Vector<GridItemWithSpan>::iterator range_start;
   Vector<GridItemWithSpan>::iterator range_end;
@@ -1207,18 +1223,47 @@ static void UpdateTrackSizeForTrackSizeComputationPhase(
   NOTREACHED();
 }
 
+LayoutUnit GridTrackSizingAlgorithm::ItemContribution(
+    GridItemContributionType type,
+    GridItemWithSpan& grid_item_with_span) const {
+  LayoutBox& grid_item = grid_item_with_span.GridItem();
+  // A non-auto min-size, or a min-size with non-visible overflow, resolves
+  // against the grid area, i.e. against the base sizes of the very tracks
+  // being sized. Those change between phases, so this isn't cached.
+  if (type == kMinSizeContribution)
+    return strategy_->MinSizeForChild(grid_item);
+
+  base::Optional<LayoutUnit>& contribution =
+      grid_item_with_span.CachedContribution(type);
+  if (contribution)
+    return *contribution;
+
+  switch (type) {
+    case kMinSizeContribution:
+      NOTREACHED();
+      break;
+    case kMinContentContribution:
+      contribution = strategy_->MinContentForChild(grid_item);
+      break;
+    case kMaxContentContribution:
+      contribution = strategy_->MaxContentForChild(grid_item);
+      break;
+  }
+  return *contribution;
+}
+
 LayoutUnit GridTrackSizingAlgorithm::ItemSizeForTrackSizeComputationPhase(
     TrackSizeComputationPhase phase,
-    LayoutBox& grid_item) const {
+    GridItemWithSpan& grid_item_with_span) const {
   switch (phase) {
     case kResolveIntrinsicMinimums:
     case kResolveIntrinsicMaximums:
-      return strategy_->MinSizeForChild(grid_item);
+      return ItemContribution(kMinSizeContribution, grid_item_with_span);
     case kResolveContentBasedMinimums:
-      return strategy_->MinContentForChild(grid_item);
+      return ItemContribution(kMinContentContribution, grid_item_with_span);
     case kResolveMaxContentMinimums:
     case kResolveMaxContentMaximums:
-      return strategy_->MaxContentForChild(grid_item);
+      return ItemContribution(kMaxContentContribution, grid_item_with_span);
     case kMaximizeTracks:
       NOTREACHED();
       return LayoutUnit();
@@ -1358,8 +1403,8 @@ void GridTrackSizingAlgorithm::IncreaseSizesToAccommodateSpanningItems(
     filtered_tracks.Shrink(0);
     LayoutUnit spanning_tracks_size;
     for (const auto& track_position : item_span) {
-      GridTrackSize track_size = GetGridTrackSize(direction_, track_position);
-      GridTrack& track = Tracks(direction_)[track_position];
+      const GridTrackSize& track_size = track_sizes_[track_position];
+      GridTrack& track = all_tracks[track_position];
       spanning_tracks_size +=
           TrackSizeForTrackSizeComputationPhase(phase, track, kForbidInfinity);
       if (!ShouldProcessTrackForTrackSizeComputationPhase(phase, track_size))
@@ -1379,9 +1424,9 @@ void GridTrackSizingAlgorithm::IncreaseSizesToAccommodateSpanningItems(
         layout_grid_->GuttersSize(grid_, direction_, item_span.StartLine(),
                                   item_span.IntegerSpan(), AvailableSpace());
 
-    LayoutUnit extra_space = ItemSizeForTrackSizeComputationPhase(
-                                 phase, grid_item_with_span.GridItem()) -
-                             spanning_tracks_size;
+    LayoutUnit extra_space =
+        ItemSizeForTrackSizeComputationPhase(phase, grid_item_with_span) -
+        spanning_tracks_size;
     extra_space = extra_space.ClampNegativeToZero();
     auto& tracks_to_grow_beyond_growth_limits =
         grow_beyond_growth_limits_tracks.IsEmpty()
@@ -1409,7 +1454,8 @@ void GridTrackSizingAlgorithm::ResolveIntrinsicTrackSizes() {
         if (items_set.insert(grid_item).is_new_entry) {
           const GridSpan& span = grid_.GridItemSpan(*grid_item, direction_);
           if (span.IntegerSpan() == 1) {
-            SizeTrackToFitNonSpanningItem(span, *grid_item, track);
+            GridItemWithSpan grid_item_with_span(*grid_item, span);
+            SizeTrackToFitNonSpanningItem(grid_item_with_span, track);
           } else if (!SpanningItemCrossesFlexibleSizedTracks(span)) {
             items_sorted_by_increasing_span.push_back(
                 GridItemWithSpan(*grid_item, span));
@@ -1759,6 +1805,7 @@ void GridTrackSizingAlgorithm::Reset() {
   content_sized_tracks_index_.Shrink(0);
   flexible_sized_tracks_index_.Shrink(0);
   auto_sized_tracks_for_stretch_index_.Shrink(0);
+  track_sizes_.Shrink(0);
   has_percent_sized_rows_indefinite_height_ = false;
   SetAvailableSpace(kForRows, base::nullopt);
   SetAvailableSpace(kForColumns, base::nullopt);
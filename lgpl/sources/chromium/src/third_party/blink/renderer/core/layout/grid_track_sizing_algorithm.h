@@ -21,6 +21,7 @@ namespace blink {
 static const int kInfinity = -1;
 
 class Grid;
+class GridItemWithSpan;
 class GridTrackSizingAlgorithmStrategy;
 class LayoutGrid;
 
@@ -33,6 +34,13 @@ enum TrackSizeComputationPhase {
   kMaximizeTracks,
 };
 
+// The contributions of a grid item to the sizes of the tracks it spans.
+enum GridItemContributionType {
+  kMinSizeContribution,
+  kMinContentContribution,
+  kMaxContentContribution,
+};
+
 class GridTrack {
   DISALLOW_NEW();
 
@@ -147,16 +155,16 @@ class GridTrackSizingAlgorithm final {
                                 LayoutUnit base_size) const;
 
   // Helper methods for step 2. resolveIntrinsicTrackSizes().
-  void SizeTrackToFitNonSpanningItem(const GridSpan&,
-                                     LayoutBox& grid_item,
-                                     GridTrack&);
+  void SizeTrackToFitNonSpanningItem(GridItemWithSpan&, GridTrack&);
   bool SpanningItemCrossesFlexibleSizedTracks(const GridSpan&) const;
   typedef struct GridItemsSpanGroupRange GridItemsSpanGroupRange;
   template <TrackSizeComputationPhase phase>
   void IncreaseSizesToAccommodateSpanningItems(
       const GridItemsSpanGroupRange& grid_items_with_span);
+  LayoutUnit ItemContribution(GridItemContributionType,
+                              GridItemWithSpan&) const;
   LayoutUnit ItemSizeForTrackSizeComputationPhase(TrackSizeComputationPhase,
-                                                  LayoutBox&) const;
+                                                  GridItemWithSpan&) const;
   template <TrackSizeComputationPhase phase>
   void DistributeSpaceToTracks(
       Vector<GridTrack*>& tracks,
@@ -223,6 +231,11 @@ class GridTrackSizingAlgorithm final {
   Vector<size_t> flexible_sized_tracks_index_;
   Vector<size_t> auto_sized_tracks_for_stretch_index_;
 
+  // The sizing functions of the tracks in |direction_|, computed once in
+  // InitializeTrackSizes() so that step 2 doesn't compute them again for
+  // every item and phase.
+  Vector<GridTrackSize> track_sizes_;
+
   GridTrackSizingDirection direction_;
 
   Grid& grid_;
@@ -15,6 +15,8 @@ namespace blink {
 
 LayoutAnalyzer::Scope::Scope(const LayoutObject& o)
     : layout_object_(o), analyzer_(o.GetFrameView()->GetLayoutAnalyzer()) {
+  if (analyzer_ && analyzer_->IsTimingOnly())
+    analyzer_ = nullptr;
   if (analyzer_)
     analyzer_->Push(o);
 }
@@ -24,6 +26,18 @@ LayoutAnalyzer::Scope::~Scope() {
     analyzer_->Pop(layout_object_);
 }
 
+LayoutAnalyzer::AlgorithmScope::AlgorithmScope(const LayoutObject& o,
+                                               Algorithm algorithm)
+    : analyzer_(o.GetFrameView()->GetLayoutAnalyzer()) {
+  if (analyzer_)
+    analyzer_->PushAlgorithm(algorithm);
+}
+
+LayoutAnalyzer::AlgorithmScope::~AlgorithmScope() {
+  if (analyzer_)
+    analyzer_->PopAlgorithm();
+}
+
 LayoutAnalyzer::BlockScope::BlockScope(const LayoutBlock& block)
     : block_(block),
       width_(block.FrameRect().Width()),
@@ -31,7 +45,7 @@ LayoutAnalyzer::BlockScope::BlockScope(const LayoutBlock& block)
 
 LayoutAnalyzer::BlockScope::~BlockScope() {
   LayoutAnalyzer* analyzer = block_.GetFrameView()->GetLayoutAnalyzer();
-  if (!analyzer)
+  if (!analyzer || analyzer->IsTimingOnly())
     return;
   bool changed = false;
   if (width_ != block_.FrameRect().Width()) {
@@ -46,11 +60,23 @@ LayoutAnalyzer::BlockScope::~BlockScope() {
                               : kLayoutBlockSizeDidNotChange);
 }
 
+void LayoutAnalyzer::IncrementFor(const LayoutObject& o,
+                                  Counter counter,
+                                  unsigned delta) {
+  if (LocalFrameView* frame_view = o.GetFrameView()) {
+    if (LayoutAnalyzer* analyzer = frame_view->GetLayoutAnalyzer())
+      analyzer->Increment(counter, delta);
+  }
+}
+
 void LayoutAnalyzer::Reset() {
   depth_ = 0;
   for (size_t i = 0; i < kNumCounters; ++i) {
     counters_[i] = 0;
   }
+  for (size_t i = 0; i < kNumAlgorithms; ++i)
+    algorithm_times_[i] = base::TimeDelta();
+  DCHECK(algorithm_stack_.IsEmpty());
 }
 
 void LayoutAnalyzer::Push(const LayoutObject& o) {
@@ -94,6 +120,21 @@ void LayoutAnalyzer::Pop(const LayoutObject& o) {
   --depth_;
 }
 
+void LayoutAnalyzer::PushAlgorithm(Algorithm algorithm) {
+  algorithm_stack_.push_back(AlgorithmStackEntry{
+      algorithm, base::TimeTicks::Now(), base::TimeDelta()});
+}
+
+void LayoutAnalyzer::PopAlgorithm() {
+  DCHECK(!algorithm_stack_.IsEmpty());
+  const AlgorithmStackEntry& entry = algorithm_stack_.back();
+  base::TimeDelta elapsed = base::TimeTicks::Now() - entry.start_time;
+  algorithm_times_[entry.algorithm] += elapsed - entry.nested_time;
+  algorithm_stack_.pop_back();
+  if (!algorithm_stack_.IsEmpty())
+    algorithm_stack_.back().nested_time += elapsed;
+}
+
 std::unique_ptr<TracedValue> LayoutAnalyzer::ToTracedValue() {
   auto traced_value(std::make_unique<TracedValue>());
   for (size_t i = 0; i < kNumCounters; ++i) {
@@ -102,6 +143,13 @@ std::unique_ptr<TracedValue> LayoutAnalyzer::ToTracedValue() {
           NameForCounter(static_cast<Counter>(i)), counters_[i]);
     }
   }
+  for (size_t i = 0; i < kNumAlgorithms; ++i) {
+    if (!algorithm_times_[i].is_zero()) {
+      traced_value->SetDoubleWithCopiedName(
+          NameForAlgorithm(static_cast<Algorithm>(i)),
+          algorithm_times_[i].InMillisecondsF());
+    }
+  }
   return traced_value;
 }
 
@@ -151,6 +199,31 @@ const char* LayoutAnalyzer::NameForCounter(Counter counter) const {
              "h";
     case kTotalLayoutObjectsThatWereLaidOut:
       return "TotalLayoutObjectsThatWereLaidOut";
+    case kNGLayoutResultCacheHits:
+      return "NGLayoutResultCacheHits";
+    case kNGLayoutResultCacheMisses:
+      return "NGLayoutResultCacheMisses";
+    case kNGLinesLaidOut:
+      return "NGLinesLaidOut";
+  }
+  NOTREACHED();
+  return "";
+}
+
+const char* LayoutAnalyzer::NameForAlgorithm(Algorithm algorithm) const {
+  switch (algorithm) {
+    case kBlockAlgorithm:
+      return "BlockAlgorithmMs";
+    case kInlineAlgorithm:
+      return "InlineAlgorithmMs";
+    case kFlexAlgorithm:
+      return "FlexAlgorithmMs";
+    case kGridAlgorithm:
+      return "GridAlgorithmMs";
+    case kTableAlgorithm:
+      return "TableAlgorithmMs";
+    case kCustomAlgorithm:
+      return "CustomAlgorithmMs";
   }
   NOTREACHED();
   return "";
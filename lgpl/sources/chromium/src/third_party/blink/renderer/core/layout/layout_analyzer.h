@@ -7,8 +7,10 @@
 
 #include <memory>
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "third_party/blink/renderer/platform/geometry/layout_unit.h"
 #include "third_party/blink/renderer/platform/wtf/allocator/allocator.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
 
 namespace blink {
 
@@ -19,6 +21,11 @@ class TracedValue;
 // Observes the performance of layout and reports statistics via a TracedValue.
 // Usage:
 // LayoutAnalyzer::Scope analyzer(*this);
+//
+// With the LayoutAnalyzerTiming runtime flag, an analyzer which only records
+// the time spent in each layout algorithm, and the cheap counters marked
+// below, is kept even when not tracing. Its statistics are accumulated over a
+// frame, see LocalFrameView::ReportLayoutAnalyzerFrameStats().
 class LayoutAnalyzer {
   USING_FAST_MALLOC(LayoutAnalyzer);
 
@@ -45,8 +52,25 @@ class LayoutAnalyzer {
     kLayoutObjectsThatAreTextAndCanUseTheSimpleFontCodePath,
     kCharactersInLayoutObjectsThatAreTextAndCanUseTheSimpleFontCodePath,
     kTotalLayoutObjectsThatWereLaidOut,
+    // The counters below are also recorded by timing-only analyzers.
+    kNGLayoutResultCacheHits,
+    kNGLayoutResultCacheMisses,
+    kNGLinesLaidOut,
   };
-  static const size_t kNumCounters = 21;
+  static const size_t kNumCounters = 24;
+
+  // Layout algorithms whose time is recorded. The time of an algorithm
+  // excludes the time of the algorithms nested in it, e.g. an inline
+  // formatting context in a block.
+  enum Algorithm {
+    kBlockAlgorithm,
+    kInlineAlgorithm,
+    kFlexAlgorithm,
+    kGridAlgorithm,
+    kTableAlgorithm,
+    kCustomAlgorithm,
+  };
+  static const size_t kNumAlgorithms = 6;
 
   class Scope {
     STACK_ALLOCATED();
@@ -60,6 +84,17 @@ class LayoutAnalyzer {
     LayoutAnalyzer* analyzer_;
   };
 
+  class AlgorithmScope {
+    STACK_ALLOCATED();
+
+   public:
+    AlgorithmScope(const LayoutObject&, Algorithm);
+    ~AlgorithmScope();
+
+   private:
+    LayoutAnalyzer* analyzer_;
+  };
+
   class BlockScope {
     STACK_ALLOCATED();
 
@@ -73,23 +108,48 @@ class LayoutAnalyzer {
     LayoutUnit height_;
   };
 
-  LayoutAnalyzer() = default;
+  explicit LayoutAnalyzer(bool timing_only = false)
+      : timing_only_(timing_only) {}
+
+  // Increments the counter on the analyzer of the frame of |o|, if any.
+  static void IncrementFor(const LayoutObject& o,
+                           Counter counter,
+                           unsigned delta = 1);
+
+  bool IsTimingOnly() const { return timing_only_; }
 
   void Reset();
   void Push(const LayoutObject&);
   void Pop(const LayoutObject&);
+  void PushAlgorithm(Algorithm);
+  void PopAlgorithm();
 
   void Increment(Counter counter, unsigned delta = 1) {
     counters_[counter] += delta;
   }
 
+  unsigned GetCounter(Counter counter) const { return counters_[counter]; }
+  base::TimeDelta AlgorithmTime(Algorithm algorithm) const {
+    return algorithm_times_[algorithm];
+  }
+
   std::unique_ptr<TracedValue> ToTracedValue();
 
  private:
   const char* NameForCounter(Counter) const;
+  const char* NameForAlgorithm(Algorithm) const;
+
+  struct AlgorithmStackEntry {
+    Algorithm algorithm;
+    base::TimeTicks start_time;
+    base::TimeDelta nested_time;
+  };
 
-  unsigned depth_;
-  unsigned counters_[kNumCounters];
+  const bool timing_only_;
+  unsigned depth_ = 0;
+  unsigned counters_[kNumCounters] = {};
+  base::TimeDelta algorithm_times_[kNumAlgorithms];
+  Vector<AlgorithmStackEntry, 8> algorithm_stack_;
   DISALLOW_COPY_AND_ASSIGN(LayoutAnalyzer);
 };
 
@@ -248,8 +248,11 @@ void LayoutBlock::StyleDidChange(StyleDifference diff,
     }
   }
 
-  if (TextAutosizer* text_autosizer = GetDocument().GetTextAutosizer())
+  if (TextAutosizer* text_autosizer = GetDocument().GetTextAutosizer()) {
+    if (old_style)
+      text_autosizer->StyleDidChange(this, *old_style);
     text_autosizer->Record(this);
+  }
 
   PropagateStyleToAnonymousChildren();
 
@@ -738,7 +741,8 @@ bool LayoutBlock::SimplifiedLayout() {
 
   ClearNeedsLayout();
 
-  if (LayoutAnalyzer* analyzer = GetFrameView()->GetLayoutAnalyzer())
+  LayoutAnalyzer* analyzer = GetFrameView()->GetLayoutAnalyzer();
+  if (analyzer && !analyzer->IsTimingOnly())
     analyzer->Increment(LayoutAnalyzer::kLayoutObjectsThatNeedSimplifiedLayout);
 
   return true;
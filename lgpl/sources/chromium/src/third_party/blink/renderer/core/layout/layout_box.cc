@@ -72,6 +72,7 @@
 #include "third_party/blink/renderer/core/layout/ng/ng_layout_result.h"
 #include "third_party/blink/renderer/core/layout/ng/ng_layout_utils.h"
 #include "third_party/blink/renderer/core/layout/ng/ng_length_utils.h"
+#include "third_party/blink/renderer/core/layout/ng/ng_physical_box_fragment.h"
 #include "third_party/blink/renderer/core/layout/shapes/shape_outside_info.h"
 #include "third_party/blink/renderer/core/page/autoscroll_controller.h"
 #include "third_party/blink/renderer/core/page/page.h"
@@ -134,6 +135,8 @@ LayoutBoxRareData::LayoutBoxRareData()
       snap_container_(nullptr),
       snap_areas_(nullptr) {}
 
+LayoutBoxRareData::~LayoutBoxRareData() = default;
+
 LayoutBox::LayoutBox(ContainerNode* node)
     : LayoutBoxModelObject(node),
       intrinsic_content_logical_height_(-1),
@@ -776,7 +779,7 @@ void LayoutBox::UpdateAfterLayout() {
   // e.g. an OOF-positioned object is laid out by an NG containing block, then
   // Legacy, then NG again, NG won't use a stale layout result.
   if (IsOutOfFlowPositioned() && !IsLayoutNGObject())
-    cached_layout_result_.reset();
+    ClearCachedLayoutResult();
 }
 
 LayoutUnit LayoutBox::LogicalHeightWithVisibleOverflow() const {
@@ -2313,11 +2316,77 @@ void LayoutBox::SetCachedLayoutResult(const NGLayoutResult& layout_result,
   if (layout_result.PhysicalFragment().BreakToken())
     return;
 
+  if (RuntimeEnabledFeatures::LayoutNGMultiEntryFragmentCachingEnabled())
+    UpdateAlternateLayoutResults(layout_result);
+
   cached_layout_result_ = &layout_result;
 }
 
 void LayoutBox::ClearCachedLayoutResult() {
   cached_layout_result_ = nullptr;
+  if (rare_data_)
+    rare_data_->alternate_layout_results_.clear();
+}
+
+void LayoutBox::UpdateAlternateLayoutResults(
+    const NGLayoutResult& new_layout_result) {
+  // If we are dirty, the layout inputs changed since the previous results
+  // were produced, and none of them may be reused.
+  if (NeedsLayout() || !IsLayoutNGMixin()) {
+    if (rare_data_)
+      rare_data_->alternate_layout_results_.clear();
+    return;
+  }
+
+  const NGPhysicalFragment& new_fragment = new_layout_result.PhysicalFragment();
+  if (rare_data_) {
+    // |new_layout_result| may be a promoted alternate result.
+    auto& alternates = rare_data_->alternate_layout_results_;
+    for (wtf_size_t i = 0; i < alternates.size(); ++i) {
+      if (&alternates[i]->PhysicalFragment() == &new_fragment) {
+        alternates.EraseAt(i);
+        break;
+      }
+    }
+  }
+
+  if (!cached_layout_result_ ||
+      &cached_layout_result_->PhysicalFragment() == &new_fragment)
+    return;
+
+  auto& alternates = EnsureRareData().alternate_layout_results_;
+  if (alternates.size() == kMaxAlternateLayoutResults)
+    alternates.pop_back();
+  alternates.push_front(std::move(cached_layout_result_));
+}
+
+// Returns true if every box fragment within |fragment| (not looking into
+// nested boxes) is the fragment of the current layout result of its
+// LayoutBox, i.e. none of the children has been laid out differently since
+// |fragment| was produced.
+static bool AreChildFragmentsCurrent(
+    const NGPhysicalContainerFragment& fragment) {
+  // Children laid out into fragment items aren't checked.
+  if (fragment.IsBox() && To<NGPhysicalBoxFragment>(fragment).HasItems())
+    return false;
+  for (const auto& child : fragment.Children()) {
+    if (child->IsBox() && !child->IsInlineBox()) {
+      const LayoutObject* layout_object = child->GetLayoutObject();
+      if (!layout_object || !layout_object->IsBox() || child->IsColumnBox())
+        return false;
+      const NGLayoutResult* child_result =
+          ToLayoutBox(layout_object)->GetCachedLayoutResult();
+      if (!child_result || &child_result->PhysicalFragment() != child.get())
+        return false;
+      continue;
+    }
+    if (child->IsContainer() &&
+        !AreChildFragmentsCurrent(
+            *To<NGPhysicalContainerFragment>(child.get()))) {
+      return false;
+    }
+  }
+  return true;
 }
 
 scoped_refptr<const NGLayoutResult> LayoutBox::CachedLayoutResult(
@@ -2342,7 +2411,59 @@ scoped_refptr<const NGLayoutResult> LayoutBox::CachedLayoutResult(
   if (early_break)
     return nullptr;
 
-  DCHECK_EQ(cached_layout_result->Status(), NGLayoutResult::kSuccess);
+  scoped_refptr<const NGLayoutResult> layout_result =
+      ReusableLayoutResult(*cached_layout_result, new_space, break_token,
+                           initial_fragment_geometry, out_cache_status);
+  if (layout_result ||
+      *out_cache_status != NGLayoutCacheStatus::kNeedsLayout ||
+      !RuntimeEnabledFeatures::LayoutNGMultiEntryFragmentCachingEnabled())
+    return layout_result;
+
+  return AlternateLayoutResult(new_space, initial_fragment_geometry,
+                               out_cache_status);
+}
+
+scoped_refptr<const NGLayoutResult> LayoutBox::AlternateLayoutResult(
+    const NGConstraintSpace& new_space,
+    base::Optional<NGFragmentGeometry>* initial_fragment_geometry,
+    NGLayoutCacheStatus* out_cache_status) {
+  DCHECK_EQ(*out_cache_status, NGLayoutCacheStatus::kNeedsLayout);
+  if (!rare_data_ || rare_data_->alternate_layout_results_.IsEmpty())
+    return nullptr;
+
+  // Alternate results were produced before the last layout of this box, so
+  // they are only valid if nothing changed since. They are copied to the
+  // legacy layout tree when reused, which isn't possible for intermediate or
+  // fragmented layouts. OOF-positioned boxes have their own two-tier cache,
+  // see |NGBlockNode::CachedLayoutResultForOutOfFlowPositioned|.
+  if (NeedsLayout() || IsOutOfFlowPositioned() ||
+      new_space.IsIntermediateLayout() || new_space.HasBlockFragmentation())
+    return nullptr;
+
+  for (const auto& alternate : rare_data_->alternate_layout_results_) {
+    if (!AreChildFragmentsCurrent(alternate->PhysicalFragment()))
+      continue;
+    NGLayoutCacheStatus cache_status;
+    scoped_refptr<const NGLayoutResult> layout_result =
+        ReusableLayoutResult(*alternate, new_space, /* break_token */ nullptr,
+                             initial_fragment_geometry, &cache_status);
+    if (layout_result) {
+      DCHECK_EQ(cache_status, NGLayoutCacheStatus::kHit);
+      *out_cache_status = cache_status;
+      return layout_result;
+    }
+  }
+  return nullptr;
+}
+
+scoped_refptr<const NGLayoutResult> LayoutBox::ReusableLayoutResult(
+    const NGLayoutResult& cached_layout_result,
+    const NGConstraintSpace& new_space,
+    const NGBreakToken* break_token,
+    base::Optional<NGFragmentGeometry>* initial_fragment_geometry,
+    NGLayoutCacheStatus* out_cache_status) {
+  *out_cache_status = NGLayoutCacheStatus::kNeedsLayout;
+  DCHECK_EQ(cached_layout_result.Status(), NGLayoutResult::kSuccess);
 
   // Set our initial temporary cache status to "hit".
   NGLayoutCacheStatus cache_status = NGLayoutCacheStatus::kHit;
@@ -2373,7 +2494,7 @@ scoped_refptr<const NGLayoutResult> LayoutBox::CachedLayoutResult(
   }
 
   const NGPhysicalContainerFragment& physical_fragment =
-      cached_layout_result->PhysicalFragment();
+      cached_layout_result.PhysicalFragment();
 
   DCHECK(!physical_fragment.BreakToken());
 
@@ -2386,7 +2507,7 @@ scoped_refptr<const NGLayoutResult> LayoutBox::CachedLayoutResult(
 
   NGBlockNode node(this);
   NGLayoutCacheStatus size_cache_status = CalculateSizeBasedLayoutCacheStatus(
-      node, *cached_layout_result, new_space, initial_fragment_geometry);
+      node, cached_layout_result, new_space, initial_fragment_geometry);
 
   // If our size may change (or we know a descendants size may change), we miss
   // the cache.
@@ -2400,12 +2521,12 @@ scoped_refptr<const NGLayoutResult> LayoutBox::CachedLayoutResult(
 
   LayoutUnit bfc_line_offset = new_space.BfcOffset().line_offset;
   base::Optional<LayoutUnit> bfc_block_offset =
-      cached_layout_result->BfcBlockOffset();
+      cached_layout_result.BfcBlockOffset();
   LayoutUnit block_offset_delta;
-  NGMarginStrut end_margin_strut = cached_layout_result->EndMarginStrut();
+  NGMarginStrut end_margin_strut = cached_layout_result.EndMarginStrut();
 
   const NGConstraintSpace& old_space =
-      cached_layout_result->GetConstraintSpaceForCaching();
+      cached_layout_result.GetConstraintSpaceForCaching();
 
   // Check the BFC offset. Even if they don't match, there're some cases we can
   // still reuse the fragment.
@@ -2455,7 +2576,7 @@ scoped_refptr<const NGLayoutResult> LayoutBox::CachedLayoutResult(
     DCHECK_EQ(cache_status, NGLayoutCacheStatus::kHit);
 
     if (!MaySkipLayoutWithinBlockFormattingContext(
-            *cached_layout_result, new_space, &bfc_block_offset,
+            cached_layout_result, new_space, &bfc_block_offset,
             &block_offset_delta, &end_margin_strut))
       return nullptr;
   }
@@ -2495,13 +2616,13 @@ scoped_refptr<const NGLayoutResult> LayoutBox::CachedLayoutResult(
       is_margin_strut_equal && !needs_cached_result_update) {
     // In order not to rebuild the internal derived-geometry "cache" of float
     // data, we need to move this to the new "output" exclusion space.
-    cached_layout_result->ExclusionSpace().MoveAndUpdateDerivedGeometry(
+    cached_layout_result.ExclusionSpace().MoveAndUpdateDerivedGeometry(
         new_space.ExclusionSpace());
-    return cached_layout_result;
+    return &cached_layout_result;
   }
 
   scoped_refptr<const NGLayoutResult> new_result =
-      base::AdoptRef(new NGLayoutResult(*cached_layout_result, new_space,
+      base::AdoptRef(new NGLayoutResult(cached_layout_result, new_space,
                                         end_margin_strut, bfc_line_offset,
                                         bfc_block_offset, block_offset_delta));
 
@@ -71,6 +71,7 @@ struct LayoutBoxRareData {
 
  public:
   LayoutBoxRareData();
+  ~LayoutBoxRareData();
 
   // For spanners, the spanner placeholder that lays us out within the multicol
   // container.
@@ -117,6 +118,11 @@ struct LayoutBoxRareData {
   // layout upon. Only created if IsCustomItem() is true.
   Persistent<CustomLayoutChild> layout_child_;
 
+  // Layout results for other constraint spaces than the one of
+  // |LayoutBox::cached_layout_result_|, most recent first. Only kept while
+  // the box stays clean. See |LayoutBox::AlternateLayoutResult|.
+  Vector<scoped_refptr<const NGLayoutResult>, 2> alternate_layout_results_;
+
   DISALLOW_COPY_AND_ASSIGN(LayoutBoxRareData);
 };
 
@@ -609,8 +615,12 @@ class CORE_EXPORT LayoutBox : public LayoutBoxModelObject {
   // CSS content-size getters. This property only applies if size containment is
   // specified, hence the names have ForSizeContainment suffix to distinguish
   // them from above.
+  // An auto display lock which remembered the size of its contents when it was
+  // acquired uses that size instead of content-size, see
+  // DisplayLockContext::LockedContentLogicalSize().
   bool HasSpecifiedContentSizeForSizeContainment() const {
-    return !StyleRef().GetContentSize().IsNone();
+    return LockedContentLogicalSize().has_value() ||
+           !StyleRef().GetContentSize().IsNone();
   }
   LayoutSize ContentLogicalSizeForSizeContainment() const {
     return LayoutSize(ContentLogicalWidthForSizeContainment(),
@@ -618,6 +628,8 @@ class CORE_EXPORT LayoutBox : public LayoutBoxModelObject {
   }
   LayoutUnit ContentLogicalWidthForSizeContainment() const {
     DCHECK(ShouldApplySizeContainment());
+    if (const auto locked_size = LockedContentLogicalSize())
+      return locked_size->Width();
     const auto& style = StyleRef();
     const auto& content_size = style.GetContentSize();
     if (content_size.IsNone())
@@ -631,6 +643,8 @@ class CORE_EXPORT LayoutBox : public LayoutBoxModelObject {
   }
   LayoutUnit ContentLogicalHeightForSizeContainment() const {
     DCHECK(ShouldApplySizeContainment());
+    if (const auto locked_size = LockedContentLogicalSize())
+      return locked_size->Height();
     const auto& style = StyleRef();
     const auto& content_size = style.GetContentSize();
     if (content_size.IsNone())
@@ -974,6 +988,11 @@ class CORE_EXPORT LayoutBox : public LayoutBoxModelObject {
       base::Optional<NGFragmentGeometry>* initial_fragment_geometry,
       NGLayoutCacheStatus* out_cache_status);
 
+  // The number of layout results kept in addition to the cached one, so that
+  // layout passes alternating between constraint spaces (e.g. a flex item
+  // measured, then stretched) don't evict each other.
+  static constexpr wtf_size_t kMaxAlternateLayoutResults = 2;
+
   void SetSpannerPlaceholder(LayoutMultiColumnSpannerPlaceholder&);
   void ClearSpannerPlaceholder();
   LayoutMultiColumnSpannerPlaceholder* SpannerPlaceholder() const final {
@@ -1706,6 +1725,13 @@ class CORE_EXPORT LayoutBox : public LayoutBoxModelObject {
   TextDirection ResolvedDirection() const;
 
  private:
+  base::Optional<LayoutSize> LockedContentLogicalSize() const {
+    auto* context = GetDisplayLockContext();
+    if (!context || !context->IsLocked())
+      return base::nullopt;
+    return context->LockedContentLogicalSize();
+  }
+
   inline bool LayoutOverflowIsSet() const {
     return overflow_ && overflow_->layout_overflow;
   }
@@ -1766,6 +1792,18 @@ class CORE_EXPORT LayoutBox : public LayoutBoxModelObject {
 
   bool LogicalHeightComputesAsNone(SizeType) const;
 
+  scoped_refptr<const NGLayoutResult> ReusableLayoutResult(
+      const NGLayoutResult& cached_layout_result,
+      const NGConstraintSpace&,
+      const NGBreakToken*,
+      base::Optional<NGFragmentGeometry>* initial_fragment_geometry,
+      NGLayoutCacheStatus* out_cache_status);
+  scoped_refptr<const NGLayoutResult> AlternateLayoutResult(
+      const NGConstraintSpace&,
+      base::Optional<NGFragmentGeometry>* initial_fragment_geometry,
+      NGLayoutCacheStatus* out_cache_status);
+  void UpdateAlternateLayoutResults(const NGLayoutResult& new_layout_result);
+
   bool IsBox() const =
       delete;  // This will catch anyone doing an unnecessary check.
 
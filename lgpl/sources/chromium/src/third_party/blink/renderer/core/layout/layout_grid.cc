@@ -31,6 +31,7 @@
 
 #include "third_party/blink/renderer/core/frame/local_frame_view.h"
 #include "third_party/blink/renderer/core/layout/grid_layout_utils.h"
+#include "third_party/blink/renderer/core/layout/layout_analyzer.h"
 #include "third_party/blink/renderer/core/layout/layout_state.h"
 #include "third_party/blink/renderer/core/layout/text_autosizer.h"
 #include "third_party/blink/renderer/core/paint/block_painter.h"
@@ -245,6 +246,8 @@ void LayoutGrid::RepeatTracksSizingIfNeeded(
 
 void LayoutGrid::UpdateBlockLayout(bool relayout_children) {
   DCHECK(NeedsLayout());
+  LayoutAnalyzer::AlgorithmScope analyzer(*this,
+                                          LayoutAnalyzer::kGridAlgorithm);
 
   // We cannot perform a simplifiedLayout() on a dirty grid that
   // has positioned items to be laid out.
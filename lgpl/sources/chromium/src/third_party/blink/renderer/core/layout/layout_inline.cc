@@ -41,6 +41,7 @@
 #include "third_party/blink/renderer/core/layout/ng/layout_ng_block_flow.h"
 #include "third_party/blink/renderer/core/layout/ng/ng_outline_utils.h"
 #include "third_party/blink/renderer/core/layout/ng/ng_physical_box_fragment.h"
+#include "third_party/blink/renderer/core/layout/text_autosizer.h"
 #include "third_party/blink/renderer/core/page/page.h"
 #include "third_party/blink/renderer/core/paint/box_painter.h"
 #include "third_party/blink/renderer/core/paint/inline_painter.h"
@@ -289,6 +290,9 @@ void LayoutInline::StyleDidChange(StyleDifference diff,
     }
   }
 
+  if (TextAutosizer* text_autosizer = GetDocument().GetTextAutosizer())
+    text_autosizer->StyleDidChange(this, old_style);
+
   if (!IsInLayoutNGInlineFormattingContext()) {
     if (!AlwaysCreateLineBoxes()) {
       bool always_create_line_boxes_new =
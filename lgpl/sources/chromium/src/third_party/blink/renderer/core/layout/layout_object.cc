@@ -1103,6 +1103,9 @@ void LayoutObject::CheckBlockPositionedObjectsNeedLayout() {
 void LayoutObject::SetPreferredLogicalWidthsDirty(
     MarkingBehavior mark_parents) {
   bitfields_.SetPreferredLogicalWidthsDirty(true);
+  if (RuntimeEnabledFeatures::IncrementalAutoTableLayoutEnabled() &&
+      IsTableCell())
+    To<LayoutTableCell>(this)->PreferredLogicalWidthsDirtied();
   if (mark_parents == kMarkContainerChain &&
       (IsText() || !StyleRef().HasOutOfFlowPosition()))
     InvalidateContainerPreferredLogicalWidths();
@@ -1141,6 +1144,9 @@ inline void LayoutObject::InvalidateContainerPreferredLogicalWidths() {
       break;
 
     o->bitfields_.SetPreferredLogicalWidthsDirty(true);
+    if (RuntimeEnabledFeatures::IncrementalAutoTableLayoutEnabled() &&
+        o->IsTableCell())
+      To<LayoutTableCell>(o)->PreferredLogicalWidthsDirtied();
     // A positioned object has no effect on the min/max width of its containing
     // block ever. We can optimize this case and not go up any further.
     if (o->StyleRef().HasOutOfFlowPosition())
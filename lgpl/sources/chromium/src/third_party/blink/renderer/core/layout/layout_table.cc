@@ -115,6 +115,8 @@ void LayoutTable::StyleDidChange(StyleDifference diff,
   if (!old_style)
     return;
 
+  table_layout_->InvalidateAllColumns();
+
   if (old_style->BorderCollapse() != StyleRef().BorderCollapse()) {
     InvalidateCollapsedBorders();
   } else {
@@ -254,6 +256,8 @@ void LayoutTable::RemoveCaption(const LayoutTableCaption* old_caption) {
 void LayoutTable::InvalidateCachedColumns() {
   column_layout_objects_valid_ = false;
   column_layout_objects_.resize(0);
+  if (table_layout_)
+    table_layout_->InvalidateAllColumns();
 }
 
 void LayoutTable::ColumnStructureChanged() {
@@ -659,6 +663,8 @@ void LayoutTable::RecalcVisualOverflow() {
 void LayoutTable::UpdateLayout() {
   DCHECK(NeedsLayout());
   LayoutAnalyzer::Scope analyzer(*this);
+  LayoutAnalyzer::AlgorithmScope algorithm_analyzer(
+      *this, LayoutAnalyzer::kTableAlgorithm);
 
   if (SimplifiedLayout())
     return;
@@ -1068,6 +1074,8 @@ void LayoutTable::SubtractCaptionRect(PhysicalRect& rect) const {
 
 void LayoutTable::MarkAllCellsWidthsDirtyAndOrNeedsLayout(
     WhatToMarkAllCells what_to_mark) {
+  if (table_layout_)
+    table_layout_->InvalidateAllColumns();
   for (LayoutObject* child = Children()->FirstChild(); child;
        child = child->NextSibling()) {
     if (!child->IsTableSection())
@@ -1298,9 +1306,18 @@ LayoutTable::ColAndColGroup LayoutTable::SlowColElementAtAbsoluteColumn(
   return ColAndColGroup();
 }
 
+void LayoutTable::CellPreferredLogicalWidthsDirtied(
+    const LayoutTableCell& cell) {
+  if (table_layout_)
+    table_layout_->CellPreferredLogicalWidthsDirtied(cell);
+}
+
 void LayoutTable::RecalcSections() const {
   DCHECK(needs_section_recalc_);
 
+  if (table_layout_)
+    table_layout_->InvalidateAllColumns();
+
   head_ = nullptr;
   foot_ = nullptr;
   first_body_ = nullptr;
@@ -413,6 +413,9 @@ class CORE_EXPORT LayoutTable final : public LayoutBlock,
   enum WhatToMarkAllCells { kMarkDirtyOnly, kMarkDirtyAndNeedsLayout };
   void MarkAllCellsWidthsDirtyAndOrNeedsLayout(WhatToMarkAllCells);
 
+  // Called by cells when their preferred logical widths are marked dirty.
+  void CellPreferredLogicalWidthsDirtied(const LayoutTableCell&);
+
   bool IsAbsoluteColumnCollapsed(unsigned absolute_column_index) const;
 
   bool IsAnyColumnEverCollapsed() const {
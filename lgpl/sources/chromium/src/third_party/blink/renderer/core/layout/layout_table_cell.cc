@@ -123,6 +123,13 @@ void LayoutTableCell::UpdateColAndRowSpanFlags() {
   has_row_span_ = GetNode() && ParseRowSpanFromDOM() != 1;
 }
 
+void LayoutTableCell::PreferredLogicalWidthsDirtied() {
+  // The cell may not be in a table yet, e.g. while the layout tree is built.
+  if (!Parent() || !Section() || !Section()->Parent())
+    return;
+  Table()->CellPreferredLogicalWidthsDirtied(*this);
+}
+
 void LayoutTableCell::ColSpanOrRowSpanChanged() {
   DCHECK(GetNode());
   DCHECK(IsHTMLTableCellElement(*GetNode()));
@@ -115,6 +115,10 @@ class CORE_EXPORT LayoutTableCell : public LayoutBlockFlow,
   // Called from HTMLTableCellElement.
   void ColSpanOrRowSpanChanged() final;
 
+  // Called from LayoutObject when the preferred logical widths of this cell
+  // are marked dirty, see IncrementalAutoTableLayout.
+  void PreferredLogicalWidthsDirtied();
+
   void SetAbsoluteColumnIndex(unsigned column) {
     CHECK_LE(column, kMaxColumnIndex);
     absolute_column_index_ = column;
@@ -6,6 +6,7 @@
 #include "third_party/blink/renderer/core/layout/layout_table_section.h"
 
 #include "third_party/blink/renderer/core/testing/core_unit_test_helper.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
 
 namespace blink {
 
@@ -380,6 +381,52 @@ TEST_F(LayoutTableTest, HasNonCollapsedBorderDecoration) {
   EXPECT_FALSE(table->HasNonCollapsedBorderDecoration());
 }
 
+TEST_F(LayoutTableTest, IncrementalAutoTableLayout) {
+  ScopedIncrementalAutoTableLayoutForTest incremental_auto_table_layout(true);
+  SetBodyInnerHTML(R"HTML(
+    <style>
+      table { border-spacing: 0 }
+      td { padding: 0 }
+    </style>
+    <table id='table'>
+      <tr>
+        <td><div id='a' style='width: 20px'></div></td>
+        <td><div style='width: 30px'></div></td>
+      </tr>
+      <tr>
+        <td id='c'><div style='width: 10px'></div></td>
+        <td><div id='b' style='width: 10px'></div></td>
+      </tr>
+    </table>
+  )HTML");
+  auto* table = GetTableByElementId("table");
+  EXPECT_EQ(LayoutUnit(50), table->MinPreferredLogicalWidth());
+  EXPECT_EQ(LayoutUnit(50), table->MaxPreferredLogicalWidth());
+
+  // Changes in a single cell only recompute its column.
+  GetDocument().getElementById("a")->setAttribute(html_names::kStyleAttr,
+                                                  "width: 40px");
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_EQ(LayoutUnit(70), table->MinPreferredLogicalWidth());
+  EXPECT_EQ(LayoutUnit(70), table->MaxPreferredLogicalWidth());
+
+  // Cells in different columns, which were changed in the same frame.
+  GetDocument().getElementById("a")->setAttribute(html_names::kStyleAttr,
+                                                  "width: 5px");
+  GetDocument().getElementById("b")->setAttribute(html_names::kStyleAttr,
+                                                  "width: 60px");
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_EQ(LayoutUnit(70), table->MinPreferredLogicalWidth());
+  EXPECT_EQ(LayoutUnit(70), table->MaxPreferredLogicalWidth());
+
+  // A structural change recomputes everything.
+  GetDocument().getElementById("c")->setAttribute(html_names::kColspanAttr,
+                                                  "2");
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_EQ(LayoutUnit(95), table->MinPreferredLogicalWidth());
+  EXPECT_EQ(LayoutUnit(95), table->MaxPreferredLogicalWidth());
+}
+
 }  // anonymous namespace
 
 }  // namespace blink
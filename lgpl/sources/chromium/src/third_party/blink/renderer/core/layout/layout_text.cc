@@ -128,6 +128,7 @@ LayoutText::LayoutText(Node* node, scoped_refptr<StringImpl> str)
       has_tab_(false),
       lines_dirty_(false),
       valid_ng_items_(false),
+      has_marked_ng_dirty_line_(false),
       has_bidi_control_items_(false),
       contains_reversed_text_(false),
       known_to_have_no_overflow_and_no_fallback_fonts_(false),
@@ -184,6 +185,9 @@ void LayoutText::StyleDidChange(StyleDifference diff,
     SetNeedsLayoutAndPrefWidthsRecalc(layout_invalidation_reason::kStyleChange);
     known_to_have_no_overflow_and_no_fallback_fonts_ = false;
   }
+  // The line box marked dirty by an in-place text change doesn't cover style
+  // changes, which may affect every line this object is in.
+  has_marked_ng_dirty_line_ = false;
 
   const ComputedStyle& new_style = StyleRef();
   ETextTransform old_transform =
@@ -198,8 +202,11 @@ void LayoutText::StyleDidChange(StyleDifference diff,
   if (!GetText().ContainsOnlyWhitespaceOrEmpty())
     new_style.GetFont().WillUseFontData(GetText());
 
+  // The autosizer weighs the amount of text in a cluster by its font size.
   TextAutosizer* text_autosizer = GetDocument().GetTextAutosizer();
-  if (!old_style && text_autosizer)
+  if (text_autosizer &&
+      (!old_style ||
+       old_style->SpecifiedFontSize() != new_style.SpecifiedFontSize()))
     text_autosizer->Record(this);
 
   if (diff.NeedsReshape()) {
@@ -236,6 +243,9 @@ void LayoutText::RemoveAndDestroyTextBoxes() {
 }
 
 void LayoutText::WillBeDestroyed() {
+  if (TextAutosizer* text_autosizer = GetDocument().GetTextAutosizer())
+    text_autosizer->Destroy(this);
+
   if (SecureTextTimer* secure_text_timer =
           g_secure_text_timers ? g_secure_text_timers->Take(this) : nullptr)
     delete secure_text_timer;
@@ -1891,7 +1901,7 @@ void LayoutText::TextDidChangeWithoutInvalidation() {
       content_capture_manager->OnNodeTextChanged(*GetNode());
   }
 
-  valid_ng_items_ = false;
+  InvalidateInlineItems();
   SetNeedsCollectInlines();
 }
 
@@ -2466,6 +2476,7 @@ void LayoutText::SetInlineItems(NGInlineItem* begin, NGInlineItem* end) {
 void LayoutText::ClearInlineItems() {
   has_bidi_control_items_ = false;
   valid_ng_items_ = false;
+  has_marked_ng_dirty_line_ = false;
   if (base::span<NGInlineItem>* items = GetNGInlineItems())
     *items = base::span<NGInlineItem>();
 }
@@ -317,7 +317,17 @@ class CORE_EXPORT LayoutText : public LayoutObject {
   const base::span<NGInlineItem>& InlineItems() const;
   // Inline items depends on context. It needs to be invalidated not only when
   // it was inserted/changed but also it was moved.
-  void InvalidateInlineItems() { valid_ng_items_ = false; }
+  void InvalidateInlineItems() {
+    valid_ng_items_ = false;
+    has_marked_ng_dirty_line_ = false;
+  }
+
+  // Whether |NGInlineNode::SetTextWithOffset()| has marked the line box at the
+  // changed offset dirty, so that |NGDirtyLines| doesn't need to mark an
+  // earlier line for this object.
+  bool HasMarkedNGDirtyLine() const { return has_marked_ng_dirty_line_; }
+  void SetHasMarkedNGDirtyLine() { has_marked_ng_dirty_line_ = true; }
+  void ClearHasMarkedNGDirtyLine() { has_marked_ng_dirty_line_ = false; }
 
   bool HasBidiControlInlineItems() const { return has_bidi_control_items_; }
   void SetHasBidiControlInlineItems() { has_bidi_control_items_ = true; }
@@ -424,6 +434,11 @@ class CORE_EXPORT LayoutText : public LayoutObject {
   // Functionally the inverse equivalent of lines_dirty_ for LayoutNG.
   unsigned valid_ng_items_ : 1;
 
+  // Used by LayoutNGText. Set when the NGInlineItems were updated in place by
+  // a text change that also marked the affected line box dirty. Cleared by
+  // layout, and by anything else that needs this object to be laid out.
+  unsigned has_marked_ng_dirty_line_ : 1;
+
   // Used by LayoutNGText. Whether there is any BidiControl type NGInlineItem
   // associated with this object. Set after layout when associating items.
   unsigned has_bidi_control_items_ : 1;
@@ -4,6 +4,8 @@
 
 #include "third_party/blink/renderer/core/layout/ng/exclusions/ng_exclusion_space.h"
 
+#include <algorithm>
+
 #include "base/optional.h"
 #include "third_party/blink/renderer/core/layout/ng/exclusions/ng_exclusion.h"
 
@@ -16,12 +18,14 @@ namespace {
 //
 // We don't explicitly check the inline-size/block-size of the opportunity as
 // they are always produced in the order.
-void InsertClosedArea(
+//
+// Returns the index the area was inserted at.
+wtf_size_t InsertClosedArea(
     const NGExclusionSpaceInternal::NGClosedArea area,
     Vector<NGExclusionSpaceInternal::NGClosedArea, 4>* areas) {
   if (areas->IsEmpty()) {
     areas->emplace_back(area);
-    return;
+    return 0;
   }
 
   // We go backwards through the list as there is a higher probability that a
@@ -43,7 +47,7 @@ void InsertClosedArea(
 #endif
 
       areas->insert(i + 1, area);
-      return;
+      return i + 1;
     }
   }
 
@@ -57,6 +61,25 @@ void InsertClosedArea(
   // LayoutUnit::Min(), and should be inserted at the front of the areas list.
   DCHECK_EQ(area.opportunity.rect.BlockStartOffset(), LayoutUnit::Min());
   areas->push_front(area);
+  return 0;
+}
+
+// Keeps |max_block_end_offsets| (see
+// |DerivedGeometry::areas_max_block_end_offset_|) in sync with |areas| after
+// an area has been inserted at |index|.
+void InsertClosedAreaMaxBlockEndOffset(
+    const Vector<NGExclusionSpaceInternal::NGClosedArea, 4>& areas,
+    wtf_size_t index,
+    Vector<LayoutUnit, 4>* max_block_end_offsets) {
+  DCHECK_EQ(areas.size(), max_block_end_offsets->size() + 1);
+  max_block_end_offsets->insert(index, LayoutUnit());
+  LayoutUnit max_block_end_offset =
+      index ? max_block_end_offsets->at(index - 1) : LayoutUnit::Min();
+  for (wtf_size_t i = index; i < areas.size(); ++i) {
+    max_block_end_offset = std::max(
+        max_block_end_offset, areas[i].opportunity.rect.BlockEndOffset());
+    max_block_end_offsets->at(i) = max_block_end_offset;
+  }
 }
 
 // Returns true if there is at least one edge between block_start and block_end.
@@ -381,9 +404,12 @@ void NGExclusionSpaceInternal::DerivedGeometry::Add(
                                                *shelf.shape_exclusions))
                                          : nullptr);
 
-          InsertClosedArea(NGClosedArea(opportunity, shelf.line_left_edges,
-                                        shelf.line_right_edges),
-                           &areas_);
+          wtf_size_t index = InsertClosedArea(
+              NGClosedArea(opportunity, shelf.line_left_edges,
+                           shelf.line_right_edges),
+              &areas_);
+          InsertClosedAreaMaxBlockEndOffset(areas_, index,
+                                            &areas_max_block_end_offset_);
         }
       }
 
@@ -567,7 +593,15 @@ void NGExclusionSpaceInternal::DerivedGeometry::IterateAllLayoutOpportunities(
     const LayoutUnit available_inline_size,
     const LambdaFunc& lambda) const {
   auto* shelves_it = shelves_.begin();
-  auto* areas_it = areas_.begin();
+
+  // Closed-off areas which end above |offset| can't intersect with the search
+  // area, skip all of them at once.
+  DCHECK_EQ(areas_.size(), areas_max_block_end_offset_.size());
+  const LayoutUnit* first_area_max_block_end_offset =
+      std::upper_bound(areas_max_block_end_offset_.begin(),
+                       areas_max_block_end_offset_.end(), offset.block_offset);
+  auto* areas_it = areas_.begin() + (first_area_max_block_end_offset -
+                                     areas_max_block_end_offset_.begin());
 
   auto* const shelves_end = shelves_.end();
   auto* const areas_end = areas_.end();
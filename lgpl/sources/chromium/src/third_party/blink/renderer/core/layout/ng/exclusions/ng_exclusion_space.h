@@ -379,6 +379,13 @@ class CORE_EXPORT NGExclusionSpaceInternal {
     // created, it can never change.
     Vector<NGClosedArea, 4> areas_;
 
+    // The running maximum of the block-end offsets of |areas_|, i.e. entry i
+    // is the largest block-end offset of areas_[0..i]. As it never decreases,
+    // we can binary search it for the first closed-off area which may
+    // intersect a given block offset, instead of walking over every closed-off
+    // area above it (of which there can be hundreds on float-heavy pages).
+    Vector<LayoutUnit, 4> areas_max_block_end_offset_;
+
     bool track_shape_exclusions_;
   };
 
@@ -284,6 +284,57 @@ TEST(NGExclusionSpaceTest, InsertBetweenShelves) {
                    NGBfcOffset(LayoutUnit(60), LayoutUnit::Max()));
 }
 
+// Tests that the closed-off areas above the search offset are skipped, and
+// the ones which intersect it are all found.
+TEST(NGExclusionSpaceTest, SkipsClosedAreasAboveOffset) {
+  NGExclusionSpace exclusion_space;
+
+  // Stack left floats of growing inline-size, each of them closes off an area
+  // above it.
+  for (int i = 0; i < 10; ++i) {
+    LayoutUnit block_start(10 * i);
+    exclusion_space.Add(NGExclusion::Create(
+        NGBfcRect(NGBfcOffset(LayoutUnit(), block_start),
+                  NGBfcOffset(LayoutUnit(10 * (i + 1)),
+                              block_start + LayoutUnit(10))),
+        EFloat::kLeft));
+  }
+
+  LayoutOpportunityVector opportunites = exclusion_space.AllLayoutOpportunities(
+      /* offset */ {LayoutUnit(), LayoutUnit(55)},
+      /* available_size */ LayoutUnit(200));
+
+  EXPECT_EQ(6u, opportunites.size());
+  TEST_OPPORTUNITY(opportunites[0], NGBfcOffset(LayoutUnit(60), LayoutUnit(55)),
+                   NGBfcOffset(LayoutUnit(200), LayoutUnit(60)));
+  TEST_OPPORTUNITY(opportunites[1], NGBfcOffset(LayoutUnit(70), LayoutUnit(55)),
+                   NGBfcOffset(LayoutUnit(200), LayoutUnit(70)));
+  TEST_OPPORTUNITY(opportunites[2], NGBfcOffset(LayoutUnit(80), LayoutUnit(55)),
+                   NGBfcOffset(LayoutUnit(200), LayoutUnit(80)));
+  TEST_OPPORTUNITY(opportunites[3], NGBfcOffset(LayoutUnit(90), LayoutUnit(55)),
+                   NGBfcOffset(LayoutUnit(200), LayoutUnit(90)));
+  TEST_OPPORTUNITY(opportunites[4],
+                   NGBfcOffset(LayoutUnit(100), LayoutUnit(55)),
+                   NGBfcOffset(LayoutUnit(200), LayoutUnit::Max()));
+  TEST_OPPORTUNITY(opportunites[5],
+                   NGBfcOffset(LayoutUnit(), LayoutUnit(100)),
+                   NGBfcOffset(LayoutUnit(200), LayoutUnit::Max()));
+
+  NGLayoutOpportunity opportunity = exclusion_space.FindLayoutOpportunity(
+      /* offset */ {LayoutUnit(), LayoutUnit(55)},
+      /* available_size */ LayoutUnit(200),
+      /* minimum_size */ LayoutUnit(135));
+  TEST_OPPORTUNITY(opportunity, NGBfcOffset(LayoutUnit(60), LayoutUnit(55)),
+                   NGBfcOffset(LayoutUnit(200), LayoutUnit(60)));
+
+  opportunity = exclusion_space.FindLayoutOpportunity(
+      /* offset */ {LayoutUnit(), LayoutUnit(55)},
+      /* available_size */ LayoutUnit(200),
+      /* minimum_size */ LayoutUnit(150));
+  TEST_OPPORTUNITY(opportunity, NGBfcOffset(LayoutUnit(), LayoutUnit(100)),
+                   NGBfcOffset(LayoutUnit(200), LayoutUnit::Max()));
+}
+
 TEST(NGExclusionSpaceTest, ZeroInlineSizeOpportunity) {
   NGExclusionSpace exclusion_space;
 
@@ -25,10 +25,12 @@ void NGDirtyLines::MarkLastFragment() {
 }
 
 void NGDirtyLines::MarkAtTextOffset(unsigned offset) {
+  NGPaintFragment* previous_line = nullptr;
+  bool previous_line_has_forced_break = false;
   for (NGPaintFragment* child : block_fragment_->Children()) {
     // Only the first dirty line is relevant.
     if (child->IsDirty())
-      break;
+      return;
 
     const auto* line =
         DynamicTo<NGPhysicalLineBoxFragment>(child->PhysicalFragment());
@@ -37,13 +39,18 @@ void NGDirtyLines::MarkAtTextOffset(unsigned offset) {
 
     const auto* break_token = To<NGInlineBreakToken>(line->BreakToken());
     DCHECK(break_token);
-    if (break_token->IsFinished())
-      break;
-
-    if (offset < break_token->TextOffset()) {
-      child->MarkLineBoxDirty();
-      break;
+    if (break_token->IsFinished() || offset < break_token->TextOffset()) {
+      // A change at the start of a line may change where the previous line
+      // breaks, e.g. when the first word becomes short enough to fit there,
+      // unless the previous line ended with a forced break.
+      if (previous_line && !previous_line_has_forced_break)
+        previous_line->MarkLineBoxDirty();
+      else
+        child->MarkLineBoxDirty();
+      return;
     }
+    previous_line = child;
+    previous_line_has_forced_break = break_token->IsForcedBreak();
   }
 }
 
@@ -30,6 +30,13 @@ class CORE_EXPORT NGDirtyLines {
   // dirty line is relevant, no further calls are necessary.
   bool HandleText(LayoutText* layout_text) {
     if (layout_text->SelfNeedsLayout()) {
+      // |NGInlineNode::SetTextWithOffset()| has marked the line at the
+      // changed offset dirty by itself. Other changes, such as style changes
+      // that keep the inline items valid, still need the line marked here.
+      if (layout_text->HasMarkedNGDirtyLine()) {
+        UpdateLastFragment(layout_text->FirstInlineFragment());
+        return false;
+      }
       MarkLastFragment();
       return true;
     }
@@ -69,7 +76,8 @@ class CORE_EXPORT NGDirtyLines {
     return false;
   }
 
-  // Mark the line box at the specified text offset dirty.
+  // Mark the line box at the specified text offset dirty. If the change may
+  // affect the line break of the previous line, it is marked instead.
   void MarkAtTextOffset(unsigned offset);
 
  private:
@@ -7,6 +7,8 @@
 #include <memory>
 
 #include "base/containers/adapters.h"
+#include "third_party/blink/renderer/core/layout/layout_analyzer.h"
+#include "third_party/blink/renderer/core/layout/layout_text.h"
 #include "third_party/blink/renderer/core/layout/ng/inline/ng_baseline.h"
 #include "third_party/blink/renderer/core/layout/ng/inline/ng_bidi_paragraph.h"
 #include "third_party/blink/renderer/core/layout/ng/inline/ng_inline_box_state.h"
@@ -190,6 +192,8 @@ void NGInlineLayoutAlgorithm::CreateLine(
   // Needs MutableResults to move ShapeResult out of the NGLineInfo.
   NGInlineItemResults* line_items = line_info->MutableResults();
   line_box_.resize(0);
+  LayoutAnalyzer::IncrementFor(*node_.GetLayoutBlockFlow(),
+                               LayoutAnalyzer::kNGLinesLaidOut);
 
   // Apply justification before placing items, because it affects size/position
   // of items, which are needed to compute inline static positions.
@@ -249,6 +253,7 @@ void NGInlineLayoutAlgorithm::CreateLine(
                          item_result.inline_size, item.BidiLevel());
       // Text boxes always need full paint invalidations.
       item.GetLayoutObject()->ClearNeedsLayoutWithFullPaintInvalidation();
+      ToLayoutText(item.GetLayoutObject())->ClearHasMarkedNGDirtyLine();
     } else if (item.Type() == NGInlineItem::kControl) {
       PlaceControlItem(item, *line_info, &item_result, box);
     } else if (item.Type() == NGInlineItem::kOpenTag) {
@@ -414,6 +419,7 @@ void NGInlineLayoutAlgorithm::PlaceControlItem(const NGInlineItem& item,
   DCHECK(item.GetLayoutObject());
   DCHECK(item.GetLayoutObject()->IsText());
   ClearNeedsLayoutIfNeeded(item.GetLayoutObject());
+  ToLayoutText(item.GetLayoutObject())->ClearHasMarkedNGDirtyLine();
 
   if (UNLIKELY(quirks_mode_ && !box->HasMetrics()))
     box->EnsureTextMetrics(*item.Style(), baseline_type_);
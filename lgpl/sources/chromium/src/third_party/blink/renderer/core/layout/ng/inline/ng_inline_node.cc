@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "build/build_config.h"
+#include "third_party/blink/renderer/core/layout/layout_analyzer.h"
 #include "third_party/blink/renderer/core/layout/layout_block_flow.h"
 #include "third_party/blink/renderer/core/layout/layout_inline.h"
 #include "third_party/blink/renderer/core/layout/layout_list_marker.h"
@@ -119,6 +120,8 @@ class ItemsBuilderForMarkLineBoxesDirty {
 
   void ClearNeedsLayout(LayoutObject* object) {
     object->ClearNeedsLayout();
+    if (object->IsText())
+      ToLayoutText(object)->ClearHasMarkedNGDirtyLine();
     DCHECK(!object->NeedsCollectInlines());
     ClearInlineFragment(object);
   }
@@ -512,6 +515,9 @@ class NGInlineNodeDataEditor final {
 
   LayoutBlockFlow* GetLayoutBlockFlow() const { return block_flow_; }
 
+  // The offset in the previous text content where the change starts.
+  unsigned StartOffset() const { return start_offset_; }
+
   // Note: We can't use |Position| for |layout_text_.GetNode()| because |Text|
   // node is already changed.
   NGInlineNodeData* Prepare(unsigned offset, unsigned length) {
@@ -776,6 +782,21 @@ bool NGInlineNode::SetTextWithOffset(LayoutText* layout_text,
   node.ShapeText(data, &previous_data->text_content, &previous_data->items);
   node.ShapeTextForFirstLineIfNeeded(data);
   node.AssociateItemsWithInlines(data);
+
+  // The LayoutText keeps its inline items, so |NGDirtyLines::HandleText()|
+  // won't mark lines dirty for it. Mark the line at the changed offset, so
+  // that the lines before it can be reused. Changes in bidi text may reorder
+  // earlier text in the paragraph; mark the first line in that case.
+  if (RuntimeEnabledFeatures::LayoutNGLineCacheEnabled()) {
+    if (const NGPaintFragment* fragment =
+            node.GetLayoutBlockFlow()->PaintFragment()) {
+      const bool may_be_bidi = previous_data->IsBidiEnabled() ||
+                               !data->text_content.Is8Bit();
+      NGDirtyLines(fragment).MarkAtTextOffset(
+          may_be_bidi ? 0 : editor.StartOffset());
+      layout_text->SetHasMarkedNGDirtyLine();
+    }
+  }
   return true;
 }
 
@@ -1327,6 +1348,8 @@ scoped_refptr<const NGLayoutResult> NGInlineNode::Layout(
     const NGConstraintSpace& constraint_space,
     const NGBreakToken* break_token,
     NGInlineChildLayoutContext* context) {
+  LayoutAnalyzer::AlgorithmScope analyzer(*GetLayoutBlockFlow(),
+                                          LayoutAnalyzer::kInlineAlgorithm);
   PrepareLayoutIfNeeded();
 
   const auto* inline_break_token = To<NGInlineBreakToken>(break_token);
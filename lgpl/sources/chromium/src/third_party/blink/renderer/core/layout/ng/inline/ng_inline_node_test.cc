@@ -23,6 +23,7 @@
 #include "third_party/blink/renderer/core/paint/ng/ng_paint_fragment.h"
 #include "third_party/blink/renderer/core/style/computed_style.h"
 #include "third_party/blink/renderer/core/svg_names.h"
+#include "third_party/blink/renderer/platform/bindings/exception_state.h"
 
 namespace blink {
 
@@ -1379,6 +1380,93 @@ TEST_F(NGInlineNodeTest, MarkLineBoxesDirtyInInlineBlock) {
   EXPECT_TRUE(lines[1]->IsDirty());
 }
 
+// Test marking line boxes when text is inserted in the middle of a text node.
+// Lines before the change should be kept clean.
+TEST_F(NGInlineNodeTest, MarkLineBoxesDirtyOnSetTextWithOffset) {
+  if (!RuntimeEnabledFeatures::LayoutNGLineCacheEnabled())
+    return;
+  SetupHtml("container",
+            "<pre id=container style='font-size: 10px'>"
+            "line1\nline2\nline3\nline4</pre>");
+
+  auto* text = To<Text>(GetElementById("container")->firstChild());
+  text->insertData(12, "X", ASSERT_NO_EXCEPTION);
+  EXPECT_FALSE(layout_block_flow_->NeedsCollectInlines());
+
+  auto lines = MarkLineBoxesDirty();
+  EXPECT_FALSE(lines[0]->IsDirty());
+  EXPECT_FALSE(lines[1]->IsDirty());
+  EXPECT_TRUE(lines[2]->IsDirty());
+
+  ForceLayout();
+  EXPECT_EQ(String("line1\nline2\nXline3\nline4"), GetText());
+}
+
+// Test marking line boxes when text is appended to a wrapped text node. The
+// line before the changed line is marked, because the change may affect where
+// it breaks.
+TEST_F(NGInlineNodeTest, MarkLineBoxesDirtyOnSetTextWithOffsetWrapped) {
+  if (!RuntimeEnabledFeatures::LayoutNGLineCacheEnabled())
+    return;
+  SetupHtml("container", R"HTML(
+    <div id=container style="font-size: 10px; width: 10ch"
+      >12345678 2234 3334 4444</div>
+  )HTML");
+
+  auto* text = To<Text>(GetElementById("container")->firstChild());
+  text->appendData(" 5555");
+
+  auto lines = MarkLineBoxesDirty();
+  EXPECT_FALSE(lines[0]->IsDirty());
+  EXPECT_TRUE(lines[1]->IsDirty());
+
+  ForceLayout();
+  EXPECT_EQ(String("12345678 2234 3334 4444 5555"), GetText());
+}
+
+// Test marking line boxes when a style change needs layout of a text, but
+// keeps its inline items. The line is not marked by |SetTextWithOffset()|, so
+// it should be marked as for any other change.
+TEST_F(NGInlineNodeTest, MarkLineBoxesDirtyOnStyleChangeKeepingItems) {
+  if (!RuntimeEnabledFeatures::LayoutNGLineCacheEnabled())
+    return;
+  SetupHtml("container",
+            "<div id=container style='font-size: 10px'>line1<br>line2<br>"
+            "<span id=contents style='display: contents'>line3</span></div>");
+
+  GetElementById("contents")
+      ->SetInlineStyleProperty(CSSPropertyID::kLineHeight, "50px");
+
+  auto lines = MarkLineBoxesDirty();
+  EXPECT_FALSE(lines[0]->IsDirty());
+  EXPECT_TRUE(lines[1]->IsDirty());
+}
+
+// Test marking line boxes when a text edited in place is laid out without
+// reusing cached lines, and then its whole text is replaced.
+TEST_F(NGInlineNodeTest, MarkLineBoxesDirtyOnSetTextAfterSetTextWithOffset) {
+  if (!RuntimeEnabledFeatures::LayoutNGLineCacheEnabled())
+    return;
+  // The out-of-flow positioned descendant prevents reusing cached lines, so
+  // the layout doesn't run |MarkLineBoxesDirty()|.
+  SetupHtml("container",
+            "<div id=container style='font-size: 10px'>line1<br>line2<br>"
+            "line3<span style='position: absolute'></span></div>");
+
+  auto* text = To<Text>(GetElementById("container")->childNodes()->item(2));
+  auto* layout_text = ToLayoutText(text->GetLayoutObject());
+  text->insertData(2, "X", ASSERT_NO_EXCEPTION);
+  EXPECT_FALSE(layout_block_flow_->NeedsCollectInlines());
+  ForceLayout();
+  EXPECT_FALSE(layout_text->HasMarkedNGDirtyLine());
+
+  layout_text->ForceSetText(String("line2 changed").Impl());
+  EXPECT_TRUE(layout_block_flow_->NeedsCollectInlines());
+
+  auto lines = MarkLineBoxesDirty();
+  EXPECT_TRUE(lines[0]->IsDirty());
+}
+
 TEST_F(NGInlineNodeTest, RemoveInlineNodeDataIfBlockBecomesEmpty1) {
   SetupHtml("container", "<div id=container><b id=remove><i>foo</i></b></div>");
   ASSERT_TRUE(layout_block_flow_->HasNGInlineNodeData());
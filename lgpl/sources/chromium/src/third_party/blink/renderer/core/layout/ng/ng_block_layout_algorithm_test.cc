@@ -145,6 +145,53 @@ TEST_F(NGBlockLayoutAlgorithmTest, Caching) {
   EXPECT_EQ(result.get(), nullptr);
 }
 
+TEST_F(NGBlockLayoutAlgorithmTest, MultiEntryCaching) {
+  ScopedLayoutNGFragmentCachingForTest layout_ng_fragment_caching(true);
+  ScopedLayoutNGMultiEntryFragmentCachingForTest multi_entry_caching(true);
+
+  SetBodyInnerHTML(R"HTML(
+    <div id="box" style="width:30px; height:40%;"></div>
+  )HTML");
+
+  NGConstraintSpace space_a = ConstructBlockLayoutTestConstraintSpace(
+      WritingMode::kHorizontalTb, TextDirection::kLtr,
+      LogicalSize(LayoutUnit(100), LayoutUnit(100)));
+  NGConstraintSpace space_b = ConstructBlockLayoutTestConstraintSpace(
+      WritingMode::kHorizontalTb, TextDirection::kLtr,
+      LogicalSize(LayoutUnit(100), LayoutUnit(200)));
+
+  auto* block_flow = To<LayoutBlockFlow>(GetLayoutObjectByElementId("box"));
+  NGBlockNode node(block_flow);
+
+  scoped_refptr<const NGLayoutResult> result_a(node.Layout(space_a, nullptr));
+  EXPECT_EQ(PhysicalSize(30, 40), result_a->PhysicalFragment().Size());
+  scoped_refptr<const NGLayoutResult> result_b(node.Layout(space_b, nullptr));
+  EXPECT_EQ(PhysicalSize(30, 80), result_b->PhysicalFragment().Size());
+
+  // The result for the previous constraint space is still available.
+  scoped_refptr<const NGLayoutResult> result =
+      RunCachedLayoutResult(space_a, node);
+  ASSERT_NE(result.get(), nullptr);
+  EXPECT_EQ(&result_a->PhysicalFragment(), &result->PhysicalFragment());
+
+  // Reusing it updates the legacy tree, and keeps the other result around.
+  result = node.Layout(space_a, nullptr);
+  EXPECT_EQ(&result_a->PhysicalFragment(), &result->PhysicalFragment());
+  EXPECT_EQ(LayoutUnit(40), block_flow->Size().Height());
+  result = RunCachedLayoutResult(space_b, node);
+  ASSERT_NE(result.get(), nullptr);
+  EXPECT_EQ(&result_b->PhysicalFragment(), &result->PhysicalFragment());
+
+  // Test layout invalidation
+  block_flow->SetNeedsLayout("");
+  result = RunCachedLayoutResult(space_b, node);
+  EXPECT_EQ(result.get(), nullptr);
+  result = node.Layout(space_a, nullptr);
+  EXPECT_NE(&result_a->PhysicalFragment(), &result->PhysicalFragment());
+  result = RunCachedLayoutResult(space_b, node);
+  EXPECT_EQ(result.get(), nullptr);
+}
+
 TEST_F(NGBlockLayoutAlgorithmTest, MinInlineSizeCaching) {
   ScopedLayoutNGFragmentCachingForTest layout_ng_fragment_caching(true);
 
@@ -9,6 +9,7 @@
 #include "third_party/blink/renderer/core/frame/local_frame_view.h"
 #include "third_party/blink/renderer/core/html/html_marquee_element.h"
 #include "third_party/blink/renderer/core/layout/box_layout_extra_input.h"
+#include "third_party/blink/renderer/core/layout/layout_analyzer.h"
 #include "third_party/blink/renderer/core/layout/layout_block_flow.h"
 #include "third_party/blink/renderer/core/layout/layout_fieldset.h"
 #include "third_party/blink/renderer/core/layout/layout_inline.h"
@@ -73,11 +74,20 @@ NOINLINE void CreateAlgorithmAndRun(const NGLayoutAlgorithmParams& params,
   callback(&algorithm);
 }
 
+inline LayoutAnalyzer::Algorithm AnalyzerAlgorithmFor(const LayoutBox& box) {
+  if (box.IsLayoutNGFlexibleBox())
+    return LayoutAnalyzer::kFlexAlgorithm;
+  if (box.IsLayoutNGCustom())
+    return LayoutAnalyzer::kCustomAlgorithm;
+  return LayoutAnalyzer::kBlockAlgorithm;
+}
+
 template <typename Callback>
 NOINLINE void DetermineAlgorithmAndRun(const NGLayoutAlgorithmParams& params,
                                        const Callback& callback) {
   const ComputedStyle& style = params.node.Style();
   const LayoutBox& box = *params.node.GetLayoutBox();
+  LayoutAnalyzer::AlgorithmScope analyzer(box, AnalyzerAlgorithmFor(box));
   if (box.IsLayoutNGFlexibleBox()) {
     CreateAlgorithmAndRun<NGFlexLayoutAlgorithm>(params, callback);
   } else if (box.IsLayoutNGCustom()) {
@@ -271,9 +281,23 @@ scoped_refptr<const NGLayoutResult> NGBlockNode::Layout(
   scoped_refptr<const NGLayoutResult> layout_result =
       box_->CachedLayoutResult(constraint_space, break_token, early_break,
                                &fragment_geometry, &cache_status);
+  LayoutAnalyzer::IncrementFor(
+      *box_, layout_result ? LayoutAnalyzer::kNGLayoutResultCacheHits
+                           : LayoutAnalyzer::kNGLayoutResultCacheMisses);
   if (layout_result) {
     DCHECK_EQ(cache_status, NGLayoutCacheStatus::kHit);
 
+    // A result reused from one of the alternate cache entries (see
+    // |LayoutBox::AlternateLayoutResult|) doesn't match the data of the
+    // legacy layout tree. Copy it over, as if we had just produced it.
+    if (&layout_result->PhysicalFragment() !=
+        &box_->GetCachedLayoutResult()->PhysicalFragment()) {
+      FinishLayout(block_flow, constraint_space, break_token, layout_result);
+      UpdateShapeOutsideInfoIfNeeded(
+          *layout_result, constraint_space.PercentageResolutionInlineSize());
+      return layout_result;
+    }
+
     // We may have to update the margins on box_; we reuse the layout result
     // even if a percentage margin may have changed.
     if (UNLIKELY(Style().MayHaveMargin() && !constraint_space.IsTableCell()))
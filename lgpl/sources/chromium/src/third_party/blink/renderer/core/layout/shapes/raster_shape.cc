@@ -73,14 +73,14 @@ IntShapeInterval MarginIntervalGenerator::IntervalAt(int y) const {
   return IntShapeInterval(x1_ - dx, x2_ + dx);
 }
 
-std::unique_ptr<RasterShapeIntervals>
+scoped_refptr<RasterShapeIntervals>
 RasterShapeIntervals::ComputeShapeMarginIntervals(int shape_margin) const {
   int margin_intervals_size = (Offset() > shape_margin)
                                   ? size()
                                   : size() - Offset() * 2 + shape_margin * 2;
-  std::unique_ptr<RasterShapeIntervals> result =
-      std::make_unique<RasterShapeIntervals>(margin_intervals_size,
-                                             std::max(shape_margin, Offset()));
+  scoped_refptr<RasterShapeIntervals> result =
+      base::MakeRefCounted<RasterShapeIntervals>(
+          margin_intervals_size, std::max(shape_margin, Offset()));
   MarginIntervalGenerator margin_interval_generator(shape_margin);
 
   for (int y = Bounds().Y(); y < Bounds().MaxY(); ++y) {
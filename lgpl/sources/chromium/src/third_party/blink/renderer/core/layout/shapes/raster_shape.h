@@ -36,11 +36,14 @@
 #include "third_party/blink/renderer/core/layout/shapes/shape_interval.h"
 #include "third_party/blink/renderer/platform/geometry/float_rect.h"
 #include "third_party/blink/renderer/platform/wtf/assertions.h"
+#include "third_party/blink/renderer/platform/wtf/ref_counted.h"
 #include "third_party/blink/renderer/platform/wtf/vector.h"
 
 namespace blink {
 
-class RasterShapeIntervals {
+// Intervals extracted from an image are immutable once their bounds are
+// initialized, and may be shared by the shapes of several boxes.
+class RasterShapeIntervals : public RefCounted<RasterShapeIntervals> {
   USING_FAST_MALLOC(RasterShapeIntervals);
 
  public:
@@ -64,7 +67,7 @@ class RasterShapeIntervals {
     return intervals_[y + offset_];
   }
 
-  std::unique_ptr<RasterShapeIntervals> ComputeShapeMarginIntervals(
+  scoped_refptr<RasterShapeIntervals> ComputeShapeMarginIntervals(
       int shape_margin) const;
 
   void BuildBoundsPath(Path&) const;
@@ -82,11 +85,9 @@ class RasterShapeIntervals {
 
 class RasterShape final : public Shape {
  public:
-  RasterShape(std::unique_ptr<RasterShapeIntervals> intervals,
+  RasterShape(scoped_refptr<const RasterShapeIntervals> intervals,
               const IntSize& margin_rect_size)
-      : intervals_(std::move(intervals)), margin_rect_size_(margin_rect_size) {
-    intervals_->InitializeBounds();
-  }
+      : intervals_(std::move(intervals)), margin_rect_size_(margin_rect_size) {}
 
   LayoutRect ShapeMarginLogicalBoundingBox() const override {
     return static_cast<LayoutRect>(MarginIntervals().Bounds());
@@ -100,11 +101,15 @@ class RasterShape final : public Shape {
       MarginIntervals().BuildBoundsPath(paths.margin_shape);
   }
 
+  const RasterShapeIntervals* IntervalsForTesting() const {
+    return intervals_.get();
+  }
+
  private:
   const RasterShapeIntervals& MarginIntervals() const;
 
-  std::unique_ptr<RasterShapeIntervals> intervals_;
-  mutable std::unique_ptr<RasterShapeIntervals> margin_intervals_;
+  scoped_refptr<const RasterShapeIntervals> intervals_;
+  mutable scoped_refptr<const RasterShapeIntervals> margin_intervals_;
   IntSize margin_rect_size_;
   DISALLOW_COPY_AND_ASSIGN(RasterShape);
 };
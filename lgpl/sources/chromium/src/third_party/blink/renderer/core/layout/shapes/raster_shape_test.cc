@@ -0,0 +1,149 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "third_party/blink/renderer/core/layout/shapes/raster_shape.h"
+
+#include <memory>
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/blink/renderer/platform/graphics/bitmap_image.h"
+#include "third_party/blink/renderer/platform/image-encoders/image_encoder.h"
+#include "third_party/blink/renderer/platform/wtf/shared_buffer.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace blink {
+
+class RasterShapeTest : public testing::Test {
+ protected:
+  // Returns a |width| x |height| bitmap image which is transparent except for
+  // |opaque_rects|.
+  scoped_refptr<Image> CreateImage(int width,
+                                   int height,
+                                   const Vector<SkIRect>& opaque_rects) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(width, height);
+    bitmap.eraseColor(SK_ColorTRANSPARENT);
+    for (const SkIRect& rect : opaque_rects)
+      bitmap.erase(SK_ColorBLACK, rect);
+
+    SkPixmap pixmap;
+    EXPECT_TRUE(bitmap.peekPixels(&pixmap));
+    Vector<unsigned char> png_data;
+    EXPECT_TRUE(
+        ImageEncoder::Encode(&png_data, pixmap, SkPngEncoder::Options()));
+
+    scoped_refptr<BitmapImage> image = BitmapImage::Create();
+    image->SetData(SharedBuffer::Create(png_data.data(), png_data.size()),
+                   true);
+    EXPECT_EQ(IntSize(width, height), image->Size());
+    return image;
+  }
+
+  std::unique_ptr<Shape> CreateRasterShape(Image* image,
+                                           const LayoutRect& image_rect,
+                                           const LayoutRect& margin_rect) {
+    return Shape::CreateRasterShape(image, 0, image_rect, margin_rect,
+                                    WritingMode::kHorizontalTb, 0);
+  }
+
+  const RasterShapeIntervals* Intervals(const Shape& shape) {
+    return static_cast<const RasterShape&>(shape).IntervalsForTesting();
+  }
+};
+
+namespace {
+
+#define TEST_EXCLUDED_INTERVAL(shapePtr, lineTop, lineHeight, expectedLeft,   \
+                               expectedRight)                                 \
+  {                                                                           \
+    LineSegment segment = shapePtr->GetExcludedInterval(lineTop, lineHeight); \
+    EXPECT_TRUE(segment.is_valid);                                            \
+    if (segment.is_valid) {                                                   \
+      EXPECT_FLOAT_EQ(expectedLeft, segment.logical_left);                    \
+      EXPECT_FLOAT_EQ(expectedRight, segment.logical_right);                  \
+    }                                                                         \
+  }
+
+#define TEST_NO_EXCLUDED_INTERVAL(shapePtr, lineTop, lineHeight)              \
+  {                                                                           \
+    LineSegment segment = shapePtr->GetExcludedInterval(lineTop, lineHeight); \
+    EXPECT_FALSE(segment.is_valid);                                           \
+  }
+
+/* A 4x2 image whose only opaque pixels are in its last column:
+ *
+ *   0,0      4,0
+ *    +-----+-+
+ *    |     |X|
+ *    +-----+-+
+ *   0,2      4,2
+ */
+TEST_F(RasterShapeTest, opaqueLastColumn) {
+  scoped_refptr<Image> image =
+      CreateImage(4, 2, {SkIRect::MakeXYWH(3, 0, 1, 2)});
+  std::unique_ptr<Shape> shape = CreateRasterShape(
+      image.get(), LayoutRect(0, 0, 4, 2), LayoutRect(0, 0, 4, 2));
+  EXPECT_FALSE(shape->IsEmpty());
+
+  TEST_EXCLUDED_INTERVAL(shape, LayoutUnit(0), LayoutUnit(1), 3, 4);
+  TEST_EXCLUDED_INTERVAL(shape, LayoutUnit(1), LayoutUnit(1), 3, 4);
+  TEST_NO_EXCLUDED_INTERVAL(shape, LayoutUnit(2), LayoutUnit(1));
+}
+
+/* A 4x4 image whose top half is opaque on the left and whose bottom half is
+ * opaque on the right. The margin box only covers the bottom half:
+ *
+ *   0,0      4,0
+ *    +---+---+
+ *    | X |   |
+ *    +---+---+ 0,2 (margin box top)
+ *    |   | X |
+ *    +---+---+
+ *   0,4      4,4
+ */
+TEST_F(RasterShapeTest, marginBoxTopInsideImage) {
+  scoped_refptr<Image> image = CreateImage(
+      4, 4, {SkIRect::MakeXYWH(0, 0, 2, 2), SkIRect::MakeXYWH(2, 2, 2, 2)});
+  std::unique_ptr<Shape> shape = CreateRasterShape(
+      image.get(), LayoutRect(0, 0, 4, 4), LayoutRect(0, 2, 4, 2));
+  EXPECT_FALSE(shape->IsEmpty());
+
+  EXPECT_EQ(LayoutRect(2, 2, 2, 2), shape->ShapeMarginLogicalBoundingBox());
+  TEST_EXCLUDED_INTERVAL(shape, LayoutUnit(2), LayoutUnit(1), 2, 4);
+  TEST_EXCLUDED_INTERVAL(shape, LayoutUnit(3), LayoutUnit(1), 2, 4);
+  TEST_NO_EXCLUDED_INTERVAL(shape, LayoutUnit(0), LayoutUnit(1));
+}
+
+// Shapes of images with the same geometry are cached by the frame key of the
+// image, so a different frame must not get the intervals of a previous one.
+TEST_F(RasterShapeTest, cachedIntervalsKeyedByFrame) {
+  const LayoutRect rect(0, 0, 2, 1);
+  scoped_refptr<Image> left_image =
+      CreateImage(2, 1, {SkIRect::MakeXYWH(0, 0, 1, 1)});
+  scoped_refptr<Image> right_image =
+      CreateImage(2, 1, {SkIRect::MakeXYWH(1, 0, 1, 1)});
+
+  std::unique_ptr<Shape> left_shape =
+      CreateRasterShape(left_image.get(), rect, rect);
+  TEST_EXCLUDED_INTERVAL(left_shape, LayoutUnit(0), LayoutUnit(1), 0, 1);
+
+  // The same frame again hits the cache, and shares its intervals.
+  std::unique_ptr<Shape> shape =
+      CreateRasterShape(left_image.get(), rect, rect);
+  TEST_EXCLUDED_INTERVAL(shape, LayoutUnit(0), LayoutUnit(1), 0, 1);
+  EXPECT_EQ(Intervals(*left_shape), Intervals(*shape));
+
+  shape = CreateRasterShape(right_image.get(), rect, rect);
+  TEST_EXCLUDED_INTERVAL(shape, LayoutUnit(0), LayoutUnit(1), 1, 2);
+  EXPECT_NE(Intervals(*left_shape), Intervals(*shape));
+
+  // Both frames stay in the cache.
+  shape = CreateRasterShape(left_image.get(), rect, rect);
+  TEST_EXCLUDED_INTERVAL(shape, LayoutUnit(0), LayoutUnit(1), 0, 1);
+  shape = CreateRasterShape(right_image.get(), rect, rect);
+  TEST_EXCLUDED_INTERVAL(shape, LayoutUnit(0), LayoutUnit(1), 1, 2);
+}
+
+}  // anonymous namespace
+
+}  // namespace blink
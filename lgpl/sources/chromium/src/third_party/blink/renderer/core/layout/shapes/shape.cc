@@ -33,6 +33,7 @@
 #include <memory>
 #include <utility>
 
+#include "base/optional.h"
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/renderer/core/css/basic_shape_functions.h"
 #include "third_party/blink/renderer/core/layout/shapes/box_shape.h"
@@ -40,8 +41,6 @@
 #include "third_party/blink/renderer/core/layout/shapes/raster_shape.h"
 #include "third_party/blink/renderer/core/layout/shapes/rectangle_shape.h"
 #include "third_party/blink/renderer/core/svg/graphics/svg_image.h"
-#include "third_party/blink/renderer/core/typed_arrays/dom_array_buffer.h"
-#include "third_party/blink/renderer/core/typed_arrays/dom_typed_array.h"
 #include "third_party/blink/renderer/platform/geometry/float_rounded_rect.h"
 #include "third_party/blink/renderer/platform/geometry/float_size.h"
 #include "third_party/blink/renderer/platform/geometry/length_functions.h"
@@ -50,6 +49,7 @@
 #include "third_party/blink/renderer/platform/graphics/paint/paint_flags.h"
 #include "third_party/blink/renderer/platform/graphics/static_bitmap_image.h"
 #include "third_party/blink/renderer/platform/wtf/math_extras.h"
+#include "third_party/blink/renderer/platform/wtf/std_lib_extras.h"
 #include "third_party/blink/renderer/platform/wtf/typed_arrays/array_buffer_contents.h"
 #include "third_party/skia/include/core/SkSurface.h"
 
@@ -222,8 +222,8 @@ std::unique_ptr<Shape> Shape::CreateShape(const BasicShape* basic_shape,
 
 std::unique_ptr<Shape> Shape::CreateEmptyRasterShape(WritingMode writing_mode,
                                                      float margin) {
-  std::unique_ptr<RasterShapeIntervals> intervals =
-      std::make_unique<RasterShapeIntervals>(0, 0);
+  scoped_refptr<RasterShapeIntervals> intervals =
+      base::MakeRefCounted<RasterShapeIntervals>(0, 0);
   std::unique_ptr<RasterShape> raster_shape =
       std::make_unique<RasterShape>(std::move(intervals), IntSize());
   raster_shape->writing_mode_ = writing_mode;
@@ -267,48 +267,109 @@ static bool ExtractImageData(Image* image,
       image_dest_rect, color_params);
 }
 
-static std::unique_ptr<RasterShapeIntervals> ExtractIntervalsFromImageData(
+static scoped_refptr<RasterShapeIntervals> ExtractIntervalsFromImageData(
     WTF::ArrayBufferContents& contents,
     float threshold,
     const IntRect& image_rect,
     const IntRect& margin_rect) {
-  DOMArrayBuffer* array_buffer = DOMArrayBuffer::Create(contents);
-  DOMUint8ClampedArray* pixel_array =
-      DOMUint8ClampedArray::Create(array_buffer, 0, array_buffer->ByteLength());
-
-  unsigned pixel_array_offset = 3;  // Each pixel is four bytes: RGBA.
+  const uint8_t* pixels = static_cast<const uint8_t*>(contents.Data());
+  const int row_stride = image_rect.Width() * 4;
+  const int alpha_offset = 3;  // Each pixel is four bytes: RGBA.
   uint8_t alpha_pixel_threshold = threshold * 255;
 
-  DCHECK_EQ(image_rect.Size().Area() * 4, pixel_array->length());
+  DCHECK_EQ(image_rect.Size().Area() * 4, contents.DataLength());
 
   int min_buffer_y = std::max(0, margin_rect.Y() - image_rect.Y());
   int max_buffer_y =
       std::min(image_rect.Height(), margin_rect.MaxY() - image_rect.Y());
 
-  std::unique_ptr<RasterShapeIntervals> intervals =
-      std::make_unique<RasterShapeIntervals>(margin_rect.Height(),
-                                             -margin_rect.Y());
+  scoped_refptr<RasterShapeIntervals> intervals =
+      base::MakeRefCounted<RasterShapeIntervals>(margin_rect.Height(),
+                                                 -margin_rect.Y());
 
+  // The interval of a row spans from its first to its last pixel above the
+  // threshold, so scan inwards from both ends of the row, and stop at the
+  // first such pixel. Only fully transparent rows are scanned in full.
   for (int y = min_buffer_y; y < max_buffer_y; ++y) {
-    int start_x = -1;
-    for (int x = 0; x < image_rect.Width(); ++x, pixel_array_offset += 4) {
-      uint8_t alpha = pixel_array->Item(pixel_array_offset);
-      bool alpha_above_threshold = alpha > alpha_pixel_threshold;
-      if (start_x == -1 && alpha_above_threshold) {
-        start_x = x;
-      } else if (start_x != -1 &&
-                 (!alpha_above_threshold || x == image_rect.Width() - 1)) {
-        int end_x = alpha_above_threshold ? x + 1 : x;
-        intervals->IntervalAt(y + image_rect.Y())
-            .Unite(IntShapeInterval(start_x + image_rect.X(),
-                                    end_x + image_rect.X()));
-        start_x = -1;
+    const uint8_t* row_alpha = pixels + y * row_stride + alpha_offset;
+    int start_x = 0;
+    while (start_x < image_rect.Width() &&
+           row_alpha[start_x * 4] <= alpha_pixel_threshold)
+      ++start_x;
+    if (start_x == image_rect.Width())
+      continue;
+    int end_x = image_rect.Width();
+    while (row_alpha[(end_x - 1) * 4] <= alpha_pixel_threshold)
+      --end_x;
+    intervals->IntervalAt(y + image_rect.Y())
+        .Unite(IntShapeInterval(start_x + image_rect.X(),
+                                end_x + image_rect.X()));
+  }
+  intervals->InitializeBounds();
+  return intervals;
+}
+
+namespace {
+
+// Keeps the intervals of the most recently extracted shape-outside images.
+// Galleries often use the same image, at the same size, as the shape-outside
+// of many floats, and each of them would otherwise rasterize and scan the
+// image again.
+class RasterShapeIntervalsCache {
+  USING_FAST_MALLOC(RasterShapeIntervalsCache);
+
+ public:
+  scoped_refptr<const RasterShapeIntervals> Get(
+      const PaintImage::FrameKey& key,
+      float threshold,
+      const IntRect& image_rect,
+      const IntRect& margin_rect) {
+    for (wtf_size_t i = 0; i < entries_.size(); ++i) {
+      const Entry& entry = entries_[i];
+      if (entry.key == key && entry.threshold == threshold &&
+          entry.image_rect == image_rect && entry.margin_rect == margin_rect) {
+        scoped_refptr<const RasterShapeIntervals> intervals = entry.intervals;
+        // Keep the entries in most recently used order.
+        if (i)
+          std::rotate(entries_.begin(), entries_.begin() + i,
+                      entries_.begin() + i + 1);
+        return intervals;
       }
     }
+    return nullptr;
   }
-  return intervals;
+
+  void Add(const PaintImage::FrameKey& key,
+           float threshold,
+           const IntRect& image_rect,
+           const IntRect& margin_rect,
+           scoped_refptr<const RasterShapeIntervals> intervals) {
+    if (entries_.size() == kMaxEntries)
+      entries_.pop_back();
+    entries_.push_front(Entry{key, threshold, image_rect, margin_rect,
+                              std::move(intervals)});
+  }
+
+ private:
+  static constexpr wtf_size_t kMaxEntries = 8;
+
+  struct Entry {
+    PaintImage::FrameKey key;
+    float threshold;
+    IntRect image_rect;
+    IntRect margin_rect;
+    scoped_refptr<const RasterShapeIntervals> intervals;
+  };
+  Vector<Entry> entries_;
+};
+
+RasterShapeIntervalsCache& GetRasterShapeIntervalsCache() {
+  DEFINE_STATIC_LOCAL(RasterShapeIntervalsCache, cache, ());
+  return cache;
 }
 
+}  // namespace
+
 static bool IsValidRasterShapeSize(const IntSize& size) {
   // Some platforms don't limit MaxDecodedImageBytes.
   constexpr size_t size32_max_bytes = 0xFFFFFFFF / 4;
@@ -331,13 +392,33 @@ std::unique_ptr<Shape> Shape::CreateRasterShape(Image* image,
     return CreateEmptyRasterShape(writing_mode, margin);
   }
 
-  WTF::ArrayBufferContents contents;
-  if (!ExtractImageData(image, image_rect.Size(), contents))
-    return CreateEmptyRasterShape(writing_mode, margin);
+  // Only the pixels of bitmap images are identified by their frame key, other
+  // images are rasterized again every time.
+  base::Optional<PaintImage::FrameKey> frame_key;
+  if (image && image->IsBitmapImage()) {
+    PaintImage paint_image = image->PaintImageForCurrentFrame();
+    if (paint_image)
+      frame_key = paint_image.GetKeyForFrame(paint_image.frame_index());
+  }
+
+  scoped_refptr<const RasterShapeIntervals> intervals;
+  if (frame_key) {
+    intervals = GetRasterShapeIntervalsCache().Get(*frame_key, threshold,
+                                                   image_rect, margin_rect);
+  }
+
+  if (!intervals) {
+    WTF::ArrayBufferContents contents;
+    if (!ExtractImageData(image, image_rect.Size(), contents))
+      return CreateEmptyRasterShape(writing_mode, margin);
 
-  std::unique_ptr<RasterShapeIntervals> intervals =
-      ExtractIntervalsFromImageData(contents, threshold, image_rect,
-                                    margin_rect);
+    intervals = ExtractIntervalsFromImageData(contents, threshold, image_rect,
+                                              margin_rect);
+    if (frame_key) {
+      GetRasterShapeIntervalsCache().Add(*frame_key, threshold, image_rect,
+                                         margin_rect, intervals);
+    }
+  }
   std::unique_ptr<RasterShape> raster_shape =
       std::make_unique<RasterShape>(std::move(intervals), margin_rect.Size());
   raster_shape->writing_mode_ = writing_mode;
@@ -28,6 +28,7 @@
 namespace blink {
 
 class LayoutTable;
+class LayoutTableCell;
 
 class TableLayoutAlgorithm {
   USING_FAST_MALLOC(TableLayoutAlgorithm);
@@ -46,6 +47,13 @@ class TableLayoutAlgorithm {
   virtual void UpdateLayout() = 0;
   virtual void WillChangeTableLayout() = 0;
 
+  // Called when the preferred logical widths of |cell| are marked dirty, so
+  // that only the affected columns need to be recomputed.
+  virtual void CellPreferredLogicalWidthsDirtied(const LayoutTableCell&) {}
+  // Called when anything other than the contents of single cells changed,
+  // e.g. the table structure or the table and column styles.
+  virtual void InvalidateAllColumns() {}
+
  protected:
   // FIXME: Once we enable SATURATED_LAYOUT_ARITHMETHIC, this should just be
   // LayoutUnit::nearlyMax(). Until then though, using nearlyMax causes
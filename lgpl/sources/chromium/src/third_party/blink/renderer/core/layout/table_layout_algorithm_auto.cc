@@ -27,6 +27,7 @@
 #include "third_party/blink/renderer/core/layout/layout_table_section.h"
 #include "third_party/blink/renderer/core/layout/text_autosizer.h"
 #include "third_party/blink/renderer/platform/geometry/calculation_value.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 
 namespace blink {
 
@@ -34,12 +35,22 @@ TableLayoutAlgorithmAuto::TableLayoutAlgorithmAuto(LayoutTable* table)
     : TableLayoutAlgorithm(table),
       has_percent_(false),
       effective_logical_width_dirty_(true),
+      needs_full_recalc_(true),
       scaled_width_from_percent_columns_() {}
 
 TableLayoutAlgorithmAuto::~TableLayoutAlgorithmAuto() = default;
 
-void TableLayoutAlgorithmAuto::RecalcColumn(unsigned eff_col) {
+void TableLayoutAlgorithmAuto::RecalcColumn(unsigned eff_col,
+                                            bool insert_span_cells) {
   Layout& column_layout = layout_struct_[eff_col];
+  Length column_logical_width = column_layout.column_logical_width;
+  column_layout = Layout();
+  column_layout.column_logical_width = column_logical_width;
+  column_layout.logical_width = column_logical_width;
+  if (column_logical_width.IsFixed()) {
+    column_layout.max_logical_width =
+        std::max<int>(0, column_logical_width.Value());
+  }
 
   LayoutTableCell* fixed_contributor = nullptr;
   LayoutTableCell* max_contributor = nullptr;
@@ -125,7 +136,7 @@ void TableLayoutAlgorithmAuto::RecalcColumn(unsigned eff_col) {
               }
               break;
             case Length::kPercent:
-              has_percent_ = true;
+              column_layout.has_percent_cell = true;
               // TODO(alancutter): Make this work correctly for calc lengths.
               if (cell_logical_width.IsPositive() &&
                   (!column_layout.logical_width.IsPercentOrCalc() ||
@@ -145,7 +156,8 @@ void TableLayoutAlgorithmAuto::RecalcColumn(unsigned eff_col) {
 
           // This spanning cell originates in this column. Insert the cell into
           // spanning cells list.
-          InsertSpanCell(cell);
+          if (insert_span_cells)
+            InsertSpanCell(cell);
         }
       }
     }
@@ -166,8 +178,9 @@ void TableLayoutAlgorithmAuto::RecalcColumn(unsigned eff_col) {
 }
 
 void TableLayoutAlgorithmAuto::FullRecalc() {
-  has_percent_ = false;
   effective_logical_width_dirty_ = true;
+  needs_full_recalc_ = false;
+  dirty_columns_.clear();
 
   unsigned n_eff_cols = table_->NumEffectiveColumns();
   layout_struct_.resize(n_eff_cols);
@@ -193,13 +206,8 @@ void TableLayoutAlgorithmAuto::FullRecalc() {
           table_->AbsoluteColumnToEffectiveColumn(current_column);
       unsigned span = column->Span();
       if (!col_logical_width.IsAuto() && span == 1 && eff_col < n_eff_cols &&
-          table_->SpanOfEffectiveColumn(eff_col) == 1) {
-        layout_struct_[eff_col].logical_width = col_logical_width;
-        if (col_logical_width.IsFixed() &&
-            layout_struct_[eff_col].max_logical_width <
-                col_logical_width.Value())
-          layout_struct_[eff_col].max_logical_width = col_logical_width.Value();
-      }
+          table_->SpanOfEffectiveColumn(eff_col) == 1)
+        layout_struct_[eff_col].column_logical_width = col_logical_width;
       current_column += span;
     }
 
@@ -210,7 +218,71 @@ void TableLayoutAlgorithmAuto::FullRecalc() {
   }
 
   for (unsigned i = 0; i < n_eff_cols; i++)
-    RecalcColumn(i);
+    RecalcColumn(i, true);
+  UpdateHasPercent();
+}
+
+void TableLayoutAlgorithmAuto::RecalcDirtyColumns() {
+  DCHECK(!needs_full_recalc_);
+  DCHECK_EQ(layout_struct_.size(), table_->NumEffectiveColumns());
+
+  // The spanning cells are unchanged, otherwise we would do a full recalc, so
+  // they aren't collected again.
+  Vector<unsigned> dirty_columns;
+  dirty_columns.swap(dirty_columns_);
+  for (unsigned eff_col : dirty_columns) {
+    if (!layout_struct_[eff_col].needs_recalc)
+      continue;
+    RecalcColumn(eff_col, false);
+    effective_logical_width_dirty_ = true;
+  }
+  UpdateHasPercent();
+
+  // RecalcColumn() clears the dirty bits of the LayoutTableCols, but may not
+  // have been called at all. A dirty LayoutTableCol would stop later
+  // invalidations from reaching the table.
+  for (LayoutObject* child = table_->Children()->FirstChild(); child;
+       child = child->NextSibling()) {
+    if (child->IsLayoutTableCol())
+      ToLayoutTableCol(child)->ClearPreferredLogicalWidthsDirtyBits();
+  }
+}
+
+void TableLayoutAlgorithmAuto::UpdateHasPercent() {
+  has_percent_ = false;
+  for (const Layout& column_layout : layout_struct_) {
+    if (column_layout.has_percent_cell) {
+      has_percent_ = true;
+      return;
+    }
+  }
+}
+
+void TableLayoutAlgorithmAuto::CellPreferredLogicalWidthsDirtied(
+    const LayoutTableCell& cell) {
+  if (needs_full_recalc_)
+    return;
+
+  // Spanning cells also contribute to the effective widths of the columns
+  // they span, and a cell without a column is being added to the table, so
+  // recompute everything in these cases.
+  if (table_->NeedsSectionRecalc() || !cell.HasSetAbsoluteColumnIndex() ||
+      cell.ColSpan() != 1) {
+    needs_full_recalc_ = true;
+    return;
+  }
+
+  unsigned eff_col =
+      table_->AbsoluteColumnToEffectiveColumn(cell.AbsoluteColumnIndex());
+  if (eff_col >= layout_struct_.size()) {
+    needs_full_recalc_ = true;
+    return;
+  }
+  Layout& column_layout = layout_struct_[eff_col];
+  if (column_layout.needs_recalc)
+    return;
+  column_layout.needs_recalc = true;
+  dirty_columns_.push_back(eff_col);
 }
 
 static bool ShouldScaleColumnsForParent(LayoutTable* table) {
@@ -282,7 +354,13 @@ void TableLayoutAlgorithmAuto::ComputeIntrinsicLogicalWidths(
     LayoutUnit& max_width) {
   TextAutosizer::TableLayoutScope text_autosizer_table_layout_scope(table_);
 
-  FullRecalc();
+  if (RuntimeEnabledFeatures::IncrementalAutoTableLayoutEnabled() &&
+      !needs_full_recalc_ &&
+      layout_struct_.size() == table_->NumEffectiveColumns()) {
+    RecalcDirtyColumns();
+  } else {
+    FullRecalc();
+  }
 
   int span_max_logical_width = CalcEffectiveLogicalWidth();
   min_width = LayoutUnit();
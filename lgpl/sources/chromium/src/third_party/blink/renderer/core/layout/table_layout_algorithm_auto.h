@@ -51,10 +51,14 @@ class TableLayoutAlgorithmAuto final : public TableLayoutAlgorithm {
                                         LayoutUnit& max_width) const override;
   void UpdateLayout() override;
   void WillChangeTableLayout() override {}
+  void CellPreferredLogicalWidthsDirtied(const LayoutTableCell&) override;
+  void InvalidateAllColumns() override { needs_full_recalc_ = true; }
 
  private:
   void FullRecalc();
-  void RecalcColumn(unsigned eff_col);
+  void RecalcDirtyColumns();
+  void RecalcColumn(unsigned eff_col, bool insert_span_cells);
+  void UpdateHasPercent();
 
   int CalcEffectiveLogicalWidth();
   void ShrinkColumnWidth(const Length::Type&, int& available);
@@ -75,8 +79,12 @@ class TableLayoutAlgorithmAuto final : public TableLayoutAlgorithm {
           effective_max_logical_width(0),
           computed_logical_width(0),
           empty_cells_only(true),
-          column_has_no_cells(true) {}
+          column_has_no_cells(true),
+          has_percent_cell(false),
+          needs_recalc(false) {}
 
+    // The width specified by a <col> element, if any.
+    Length column_logical_width;
     Length logical_width;
     Length effective_logical_width;
     int min_logical_width;
@@ -86,6 +94,8 @@ class TableLayoutAlgorithmAuto final : public TableLayoutAlgorithm {
     int computed_logical_width;
     bool empty_cells_only;
     bool column_has_no_cells;
+    bool has_percent_cell;
+    bool needs_recalc;
     int ClampedEffectiveMaxLogicalWidth() {
       return std::max<int>(1, effective_max_logical_width);
     }
@@ -93,8 +103,12 @@ class TableLayoutAlgorithmAuto final : public TableLayoutAlgorithm {
 
   Vector<Layout, 4> layout_struct_;
   Vector<LayoutTableCell*, 4> span_cells_;
+  // Columns to recompute in the next ComputeIntrinsicLogicalWidths(), unless
+  // |needs_full_recalc_| is set.
+  Vector<unsigned> dirty_columns_;
   bool has_percent_ : 1;
   mutable bool effective_logical_width_dirty_ : 1;
+  bool needs_full_recalc_ : 1;
   LayoutUnit scaled_width_from_percent_columns_;
 };
 
@@ -265,6 +265,8 @@ TextAutosizer::TextAutosizer(const Document* document)
 TextAutosizer::~TextAutosizer() = default;
 
 void TextAutosizer::Record(LayoutBlock* block) {
+  InvalidateCachedTextLengths(block);
+
   if (!page_info_.setting_enabled_)
     return;
 
@@ -290,14 +292,45 @@ void TextAutosizer::Record(LayoutBlock* block) {
 }
 
 void TextAutosizer::Record(LayoutText* text) {
-  if (!text || !ShouldHandleLayout())
+  if (!text)
+    return;
+  InvalidateCachedTextLengths(text);
+  if (!ShouldHandleLayout())
     return;
   LayoutObject* parent = GetParent(text);
   if (parent && parent->EverHadLayout())
     MarkSuperclusterForConsistencyCheck(parent);
 }
 
+void TextAutosizer::StyleDidChange(LayoutBlock* block,
+                                   const ComputedStyle& old_style) {
+  if (cached_text_lengths_.IsEmpty())
+    return;
+  // BlockHeightConstrained() walks up the containing blocks of the blocks in a
+  // cluster, past the cluster root, so these properties decide which
+  // descendants of |block| count towards the text length of their clusters.
+  const ComputedStyle& new_style = block->StyleRef();
+  if (old_style.Height() != new_style.Height() ||
+      old_style.MaxHeight() != new_style.MaxHeight() ||
+      old_style.OverflowY() != new_style.OverflowY() ||
+      old_style.GetPosition() != new_style.GetPosition() ||
+      old_style.IsFloating() != new_style.IsFloating())
+    InvalidateCachedTextLengthsInSubtree(block);
+}
+
+void TextAutosizer::StyleDidChange(LayoutInline* layout_inline,
+                                   const ComputedStyle* old_style) {
+  // BlockIsRowOfLinks() decides whether a block is suppressed from the link
+  // status and font size of its inline descendants.
+  const ComputedStyle& new_style = layout_inline->StyleRef();
+  if (!old_style || old_style->IsLink() != new_style.IsLink() ||
+      old_style->SpecifiedFontSize() != new_style.SpecifiedFontSize())
+    InvalidateCachedTextLengths(layout_inline);
+}
+
 void TextAutosizer::Destroy(LayoutBlock* block) {
+  InvalidateCachedTextLengths(block);
+
   if (!page_info_.setting_enabled_ && !fingerprint_mapper_.HasFingerprints())
     return;
 
@@ -314,6 +347,44 @@ void TextAutosizer::Destroy(LayoutBlock* block) {
   }
 }
 
+void TextAutosizer::Destroy(LayoutText* text) {
+  InvalidateCachedTextLengths(text);
+}
+
+void TextAutosizer::InvalidateCachedTextLengths(
+    const LayoutObject* layout_object) {
+  if (cached_text_lengths_.IsEmpty())
+    return;
+  // The whole layout tree is going away, don't bother with its ancestors.
+  if (!document_->IsActive()) {
+    cached_text_lengths_.clear();
+    return;
+  }
+  // A new object gets its style before it is inserted into the layout tree.
+  const LayoutObject* start = layout_object;
+  if (!start->Parent()) {
+    if (LayoutObject* parent = GetParent(start))
+      start = parent;
+  }
+  // Ancestor clusters count the text of their non-independent descendant
+  // clusters too, so all of them are invalidated.
+  for (const LayoutObject* object = start; object; object = object->Parent()) {
+    if (auto* block = DynamicTo<LayoutBlock>(object))
+      cached_text_lengths_.erase(block);
+  }
+}
+
+void TextAutosizer::InvalidateCachedTextLengthsInSubtree(
+    const LayoutBlock* block) {
+  Vector<const LayoutBlock*> roots_to_invalidate;
+  for (const auto& entry : cached_text_lengths_) {
+    if (entry.key->IsDescendantOf(block))
+      roots_to_invalidate.push_back(entry.key);
+  }
+  for (const LayoutBlock* root : roots_to_invalidate)
+    cached_text_lengths_.erase(root);
+}
+
 TextAutosizer::BeginLayoutBehavior TextAutosizer::PrepareForLayout(
     LayoutBlock* block) {
 #if DCHECK_IS_ON()
@@ -796,10 +867,33 @@ bool TextAutosizer::ClusterHasEnoughTextToAutosize(
             .Width();
   }
 
+  if (TextLengthInCluster(root, minimum_text_length_to_autosize) >=
+      minimum_text_length_to_autosize) {
+    cluster->has_enough_text_to_autosize_ = kHasEnoughText;
+    return true;
+  }
+
+  cluster->has_enough_text_to_autosize_ = kNotEnoughText;
+  return false;
+}
+
+float TextAutosizer::TextLengthInCluster(const LayoutBlock* root,
+                                         float minimum_text_length) {
+  auto it = cached_text_lengths_.find(root);
+  if (it != cached_text_lengths_.end() &&
+      (it->value.is_complete || it->value.length >= minimum_text_length))
+    return it->value.length;
+
   float length = 0;
+  // Whether a multi-column descendant is independent depends on its column
+  // count, i.e. on its width, so the length isn't only a function of content.
+  bool is_cacheable = true;
   LayoutObject* descendant = root->FirstChild();
   while (descendant) {
     if (descendant->IsLayoutBlock()) {
+      auto* block_flow = DynamicTo<LayoutBlockFlow>(descendant);
+      if (block_flow && block_flow->MultiColumnFlowThread())
+        is_cacheable = false;
       if (ClassifyBlock(descendant, INDEPENDENT | SUPPRESSING)) {
         descendant = descendant->NextInPreOrderAfterChildren(root);
         continue;
@@ -812,16 +906,18 @@ bool TextAutosizer::ClusterHasEnoughTextToAutosize(
       length += ToLayoutText(descendant)->GetText().StripWhiteSpace().length() *
                 descendant->StyleRef().SpecifiedFontSize();
 
-      if (length >= minimum_text_length_to_autosize) {
-        cluster->has_enough_text_to_autosize_ = kHasEnoughText;
-        return true;
+      if (length >= minimum_text_length) {
+        if (is_cacheable)
+          cached_text_lengths_.Set(root, CachedTextLength{length, false});
+        return length;
       }
     }
     descendant = descendant->NextInPreOrder(root);
   }
 
-  cluster->has_enough_text_to_autosize_ = kNotEnoughText;
-  return false;
+  if (is_cacheable)
+    cached_text_lengths_.Set(root, CachedTextLength{length, true});
+  return length;
 }
 
 TextAutosizer::Fingerprint TextAutosizer::GetFingerprint(
@@ -43,10 +43,12 @@
 
 namespace blink {
 
+class ComputedStyle;
 class Document;
 class Frame;
 class IntSize;
 class LayoutBlock;
+class LayoutInline;
 class LayoutNGTableInterface;
 class LayoutObject;
 class LayoutText;
@@ -76,7 +78,10 @@ class CORE_EXPORT TextAutosizer final : public GarbageCollected<TextAutosizer> {
   void UpdatePageInfo();
   void Record(LayoutBlock*);
   void Record(LayoutText*);
+  void StyleDidChange(LayoutBlock*, const ComputedStyle& old_style);
+  void StyleDidChange(LayoutInline*, const ComputedStyle* old_style);
   void Destroy(LayoutBlock*);
+  void Destroy(LayoutText*);
 
   bool PageNeedsAutosizing() const;
 
@@ -241,6 +246,20 @@ class CORE_EXPORT TextAutosizer final : public GarbageCollected<TextAutosizer> {
   typedef unsigned Fingerprint;
   typedef Vector<std::unique_ptr<Cluster>> ClusterStack;
 
+  // The amount of text in a cluster, as computed by TextLengthInCluster().
+  // Clusters are re-created on every layout, but the text they contain rarely
+  // changes, so this is kept across layouts until the content of the cluster
+  // changes (see InvalidateCachedTextLengths()).
+  struct CachedTextLength {
+    DISALLOW_NEW();
+
+    float length = 0;
+    // If false, |length| is only a lower bound, as the text walk stopped once
+    // there was enough text to autosize.
+    bool is_complete = false;
+  };
+  typedef HashMap<const LayoutBlock*, CachedTextLength> CachedTextLengthMap;
+
   // Fingerprints are computed during style recalc, for (some subset of)
   // blocks that will become cluster roots.
   // Clusters whose roots share the same fingerprint use the same multiplier
@@ -312,6 +331,13 @@ class CORE_EXPORT TextAutosizer final : public GarbageCollected<TextAutosizer> {
   bool ClusterWouldHaveEnoughTextToAutosize(
       const LayoutBlock* root,
       const LayoutBlock* width_provider = nullptr);
+  // Returns the approximate width of the text in the cluster rooted at |root|,
+  // or any value of at least |minimum_text_length| if it has more text.
+  float TextLengthInCluster(const LayoutBlock* root, float minimum_text_length);
+  // Drops the cached text lengths of the clusters containing |layout_object|.
+  void InvalidateCachedTextLengths(const LayoutObject* layout_object);
+  // Drops the cached text lengths of the clusters rooted inside |block|.
+  void InvalidateCachedTextLengthsInSubtree(const LayoutBlock* block);
   Fingerprint GetFingerprint(LayoutObject*);
   Fingerprint ComputeFingerprint(const LayoutObject*);
   Cluster* MaybeCreateCluster(LayoutBlock*);
@@ -364,6 +390,7 @@ class CORE_EXPORT TextAutosizer final : public GarbageCollected<TextAutosizer> {
   // Clusters are created and destroyed during layout
   ClusterStack cluster_stack_;
   FingerprintMapper fingerprint_mapper_;
+  CachedTextLengthMap cached_text_lengths_;
   // FIXME: All frames should share the same m_pageInfo instance.
   PageInfo page_info_;
   bool update_page_info_deferred_;
@@ -1040,6 +1040,125 @@ TEST_F(TextAutosizerTest, ClusterHasEnoughTextToAutosizeForZoomDSF) {
                   target->GetLayoutObject()->StyleRef().ComputedFontSize());
 }
 
+TEST_F(TextAutosizerTest, ClusterTextLengthUpdatedAfterTextChange) {
+  SetBodyInnerHTML(R"HTML(
+    <style>
+      html { font-size: 8px; }
+    </style>
+    <body>
+      <div id='target'>
+        Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed
+        do eiusmod tempor incididunt ut labore et dolore magna aliqua.
+      </div>
+    </body>
+  )HTML");
+  Element* target = GetDocument().getElementById("target");
+  EXPECT_FLOAT_EQ(8.0f,
+                  target->GetLayoutObject()->StyleRef().ComputedFontSize());
+
+  // The cached text length of the cluster must not survive the addition of
+  // enough text to autosize it.
+  target->setTextContent(
+      "Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed do "
+      "eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim ad "
+      "minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip "
+      "ex ea commodo consequat. Duis aute irure dolor in reprehenderit in "
+      "voluptate velit esse cillum dolore eu fugiat nulla pariatur. Excepteur "
+      "sint occaecat cupidatat non proident, sunt in culpa qui officia "
+      "deserunt mollit anim id est laborum.");
+  UpdateAllLifecyclePhasesForTest();
+  // (specified font-size = 8px) * (thread flow layout width = 800px) /
+  // (window width = 320px) = 20px.
+  EXPECT_FLOAT_EQ(20.0f,
+                  target->GetLayoutObject()->StyleRef().ComputedFontSize());
+
+  // Shrinking the font size below the threshold goes through the style path.
+  target->setAttribute(html_names::kStyleAttr, "font-size: 4px");
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_FLOAT_EQ(4.0f,
+                  target->GetLayoutObject()->StyleRef().ComputedFontSize());
+}
+
+TEST_F(TextAutosizerTest, ClusterTextLengthUpdatedAfterAncestorHeightChange) {
+  SetBodyInnerHTML(R"HTML(
+    <style>
+      html { font-size: 8px; }
+      #target { display: flex; }
+    </style>
+    <body>
+      <div id='ancestor'>
+        <div id='target'>
+          <div id='text'>
+            Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed do
+            eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim
+            ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut
+            aliquip ex ea commodo consequat. Duis aute irure dolor in
+            reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla
+            pariatur. Excepteur sint occaecat cupidatat non proident, sunt in
+            culpa qui officia deserunt mollit anim id est laborum.
+          </div>
+        </div>
+      </div>
+    </body>
+  )HTML");
+  Element* text = GetDocument().getElementById("text");
+  EXPECT_LT(8.0f, text->GetLayoutObject()->StyleRef().ComputedFontSize());
+
+  // A height on an ancestor of the flexbox cluster root suppresses autosizing
+  // of the text inside it, so the cached length of the cluster is stale.
+  Element* ancestor = GetDocument().getElementById("ancestor");
+  ancestor->setAttribute(html_names::kStyleAttr, "height: 100px");
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_FLOAT_EQ(8.0f, text->GetLayoutObject()->StyleRef().ComputedFontSize());
+
+  ancestor->removeAttribute(html_names::kStyleAttr);
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_LT(8.0f, text->GetLayoutObject()->StyleRef().ComputedFontSize());
+}
+
+TEST_F(TextAutosizerTest, ClusterTextLengthUpdatedAfterLinkChange) {
+  SetBodyInnerHTML(R"HTML(
+    <style>
+      html { font-size: 8px; }
+      a:link { padding: 0 1px; }
+    </style>
+    <body>
+      <div id='links'>
+        <a id='first' href='#'>
+          Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed do
+          eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim
+          ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut
+          aliquip ex ea commodo consequat.
+        </a>
+        <a href='#'>b</a>
+        <a href='#'>c</a>
+      </div>
+      <div>
+        Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed do
+        eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim ad
+        minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip
+        ex ea commodo consequat.
+      </div>
+    </body>
+  )HTML");
+  Element* first = GetDocument().getElementById("first");
+  // The text of a row of links doesn't count towards the cluster, so there is
+  // not enough text to autosize.
+  EXPECT_FLOAT_EQ(8.0f,
+                  first->GetLayoutObject()->StyleRef().ComputedFontSize());
+
+  // Once the first anchor isn't a link, the block isn't a row of links and
+  // its text makes the cached length of the cluster stale.
+  first->removeAttribute(html_names::kHrefAttr);
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_LT(8.0f, first->GetLayoutObject()->StyleRef().ComputedFontSize());
+
+  first->setAttribute(html_names::kHrefAttr, "#");
+  UpdateAllLifecyclePhasesForTest();
+  EXPECT_FLOAT_EQ(8.0f,
+                  first->GetLayoutObject()->StyleRef().ComputedFontSize());
+}
+
 TEST_F(TextAutosizerTest, AfterPrint) {
   const float device_scale = 3;
   FloatSize print_size(160, 240);
@@ -28,8 +28,10 @@
 
 #include "third_party/blink/public/mojom/fetch/fetch_api_request.mojom-blink.h"
 #include "third_party/blink/public/mojom/loader/request_context_frame_type.mojom-blink.h"
+#include "third_party/blink/renderer/core/css/parser/css_block_skip_index.h"
 #include "third_party/blink/renderer/core/css/style_sheet_contents.h"
 #include "third_party/blink/renderer/core/frame/web_feature.h"
+#include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
 #include "third_party/blink/renderer/platform/loader/fetch/fetch_parameters.h"
 #include "third_party/blink/renderer/platform/loader/fetch/memory_cache.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_fetcher.h"
@@ -38,6 +40,9 @@
 #include "third_party/blink/renderer/platform/network/http_names.h"
 #include "third_party/blink/renderer/platform/network/mime/mime_type_registry.h"
 #include "third_party/blink/renderer/platform/runtime_enabled_features.h"
+#include "third_party/blink/renderer/platform/scheduler/public/post_cross_thread_task.h"
+#include "third_party/blink/renderer/platform/scheduler/public/worker_pool.h"
+#include "third_party/blink/renderer/platform/wtf/cross_thread_functional.h"
 #include "third_party/blink/renderer/platform/weborigin/security_policy.h"
 #include "third_party/blink/renderer/platform/wtf/text/text_encoding.h"
 
@@ -138,11 +143,87 @@ const String CSSStyleSheetResource::SheetText(
   return DecodedText();
 }
 
+void CSSStyleSheetResource::Finish(base::TimeTicks finish_time,
+                                   base::SingleThreadTaskRunner* task_runner) {
+  finish_task_runner_ = task_runner;
+  TextResource::Finish(finish_time, task_runner);
+  finish_task_runner_ = nullptr;
+}
+
 void CSSStyleSheetResource::NotifyFinished() {
   // Decode the data to find out the encoding and cache the decoded sheet text.
   if (Data())
     SetDecodedSheetText(DecodedText());
 
+  if (RuntimeEnabledFeatures::OffMainThreadCSSScanningEnabled() &&
+      finish_task_runner_ && !is_building_block_skip_index_ &&
+      !block_skip_index_ &&
+      decoded_sheet_text_.length() >= kMinimumLengthForBlockSkipIndex) {
+    // Tokenizing the sheet to find the end of its blocks is done on a worker
+    // thread, so that the main thread only tokenizes selectors and at-rule
+    // preludes when the clients parse the sheet.
+    is_building_block_skip_index_ = true;
+    block_skip_index_source_text_ = decoded_sheet_text_;
+    worker_pool::PostTask(
+        FROM_HERE,
+        CrossThreadBindOnce(
+            &CSSStyleSheetResource::BuildBlockSkipIndexOnBackgroundThread,
+            decoded_sheet_text_, finish_task_runner_,
+            WrapCrossThreadWeakPersistent(this)));
+    return;
+  }
+
+  NotifyClientsFinished();
+}
+
+// static
+void CSSStyleSheetResource::BuildBlockSkipIndexOnBackgroundThread(
+    const String& sheet_text,
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner,
+    CrossThreadWeakPersistent<CSSStyleSheetResource> resource) {
+  DCHECK(!IsMainThread());
+  TRACE_EVENT1("blink,blink_style",
+               "CSSStyleSheetResource::BuildBlockSkipIndexOnBackgroundThread",
+               "length", sheet_text.length());
+  std::unique_ptr<CSSBlockSkipIndex> index =
+      CSSBlockSkipIndex::Create(sheet_text);
+  PostCrossThreadTask(
+      *task_runner, FROM_HERE,
+      CrossThreadBindOnce(&CSSStyleSheetResource::DidBuildBlockSkipIndex,
+                          std::move(resource), std::move(index)));
+}
+
+void CSSStyleSheetResource::DidBuildBlockSkipIndex(
+    std::unique_ptr<CSSBlockSkipIndex> index) {
+  DCHECK(IsMainThread());
+  DCHECK(is_building_block_skip_index_);
+  is_building_block_skip_index_ = false;
+  index->SetSourceText(block_skip_index_source_text_);
+  block_skip_index_source_text_ = String();
+  // The decoded text may have been replaced or dropped in the meantime, e.g.
+  // by a failed revalidation.
+  if (index->IsFor(decoded_sheet_text_))
+    block_skip_index_ = std::move(index);
+  NotifyClientsFinished();
+}
+
+const CSSBlockSkipIndex* CSSStyleSheetResource::BlockSkipIndexFor(
+    const String& sheet_text) const {
+  if (!block_skip_index_ || !block_skip_index_->IsFor(sheet_text))
+    return nullptr;
+  return block_skip_index_.get();
+}
+
+void CSSStyleSheetResource::DidAddClient(ResourceClient* client) {
+  // Leave a client added while the block skip index is being built in
+  // |clients_|, so that NotifyClientsFinished() notifies it together with the
+  // others, and it parses the sheet with the index too.
+  if (is_building_block_skip_index_)
+    return;
+  TextResource::DidAddClient(client);
+}
+
+void CSSStyleSheetResource::NotifyClientsFinished() {
   Resource::NotifyFinished();
 
   // Clear raw bytes as now we have the full decoded sheet text.
@@ -254,6 +335,7 @@ void CSSStyleSheetResource::SaveParsedStyleSheet(StyleSheetContents* sheet) {
 void CSSStyleSheetResource::SetDecodedSheetText(
     const String& decoded_sheet_text) {
   decoded_sheet_text_ = decoded_sheet_text;
+  block_skip_index_.reset();
   UpdateDecodedSize();
 }
 
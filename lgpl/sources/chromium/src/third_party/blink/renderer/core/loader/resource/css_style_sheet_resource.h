@@ -26,14 +26,19 @@
 #ifndef THIRD_PARTY_BLINK_RENDERER_CORE_LOADER_RESOURCE_CSS_STYLE_SHEET_RESOURCE_H_
 #define THIRD_PARTY_BLINK_RENDERER_CORE_LOADER_RESOURCE_CSS_STYLE_SHEET_RESOURCE_H_
 
+#include <memory>
+
+#include "base/single_thread_task_runner.h"
 #include "third_party/blink/renderer/core/core_export.h"
 #include "third_party/blink/renderer/core/loader/resource/text_resource.h"
 #include "third_party/blink/renderer/platform/heap/handle.h"
+#include "third_party/blink/renderer/platform/heap/persistent.h"
 #include "third_party/blink/renderer/platform/loader/fetch/text_resource_decoder_options.h"
 #include "third_party/blink/renderer/platform/wtf/text/text_encoding.h"
 
 namespace blink {
 
+class CSSBlockSkipIndex;
 class CSSParserContext;
 class FetchParameters;
 class KURL;
@@ -56,6 +61,8 @@ class CORE_EXPORT CSSStyleSheetResource final : public TextResource {
 
   ~CSSStyleSheetResource() override;
   void Trace(blink::Visitor*) override;
+  void Finish(base::TimeTicks finish_time,
+              base::SingleThreadTaskRunner*) override;
   void OnMemoryDump(WebMemoryDumpLevelOfDetail,
                     WebProcessMemoryDump*) const override;
 
@@ -63,6 +70,9 @@ class CORE_EXPORT CSSStyleSheetResource final : public TextResource {
                          MIMETypeCheck = MIMETypeCheck::kStrict) const;
   StyleSheetContents* CreateParsedStyleSheetFromCache(const CSSParserContext*);
   void SaveParsedStyleSheet(StyleSheetContents*);
+  // Returns the CSSBlockSkipIndex of |sheet_text| if it is the decoded sheet
+  // text of this resource and the index was built off the main thread.
+  const CSSBlockSkipIndex* BlockSkipIndexFor(const String& sheet_text) const;
   network::mojom::ReferrerPolicy GetReferrerPolicy() const;
 
  private:
@@ -81,8 +91,19 @@ class CORE_EXPORT CSSStyleSheetResource final : public TextResource {
     }
   };
 
+  // Sheets shorter than this are parsed as soon as they finish loading.
+  static constexpr wtf_size_t kMinimumLengthForBlockSkipIndex = 32 * 1024;
+
+  static void BuildBlockSkipIndexOnBackgroundThread(
+      const String& sheet_text,
+      scoped_refptr<base::SingleThreadTaskRunner>,
+      CrossThreadWeakPersistent<CSSStyleSheetResource>);
+
   bool CanUseSheet(const CSSParserContext*, MIMETypeCheck) const;
+  void DidAddClient(ResourceClient*) override;
   void NotifyFinished() override;
+  void NotifyClientsFinished();
+  void DidBuildBlockSkipIndex(std::unique_ptr<CSSBlockSkipIndex>);
 
   void SetParsedStyleSheetCache(StyleSheetContents*);
   void SetDecodedSheetText(const String&);
@@ -96,6 +117,16 @@ class CORE_EXPORT CSSStyleSheetResource final : public TextResource {
   String decoded_sheet_text_;
 
   Member<StyleSheetContents> parsed_style_sheet_cache_;
+
+  // Built from |decoded_sheet_text_| on a worker thread when
+  // OffMainThreadCSSScanning is enabled. Clients, including the ones added
+  // in the meantime, are notified that the resource finished once it is
+  // available.
+  std::unique_ptr<CSSBlockSkipIndex> block_skip_index_;
+  scoped_refptr<base::SingleThreadTaskRunner> finish_task_runner_;
+  bool is_building_block_skip_index_ = false;
+  // The text the worker thread is building an index from.
+  String block_skip_index_source_text_;
 };
 
 DEFINE_RESOURCE_TYPE_CASTS(CSSStyleSheet);
@@ -20,6 +20,7 @@
 #include "third_party/blink/renderer/core/css/parser/css_parser_selector.h"
 #include "third_party/blink/renderer/core/css/style_rule.h"
 #include "third_party/blink/renderer/core/css/style_sheet_contents.h"
+#include "third_party/blink/renderer/core/css/style_sheet_contents_cache.h"
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/loader/resource/image_resource.h"
 #include "third_party/blink/renderer/core/testing/page_test_base.h"
@@ -30,6 +31,7 @@
 #include "third_party/blink/renderer/platform/loader/fetch/memory_cache.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_fetcher.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_request.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
 #include "third_party/blink/renderer/platform/testing/unit_test_helpers.h"
 #include "third_party/blink/renderer/platform/testing/url_test_helpers.h"
 #include "third_party/blink/renderer/platform/weborigin/kurl.h"
@@ -73,6 +75,29 @@ class CSSStyleSheetResourceTest : public PageTestBase {
     return css_resource;
   }
 
+  StyleSheetContents* ParseAuthorStyleSheet(const char* url,
+                                            const char* sheet_text) {
+    const KURL css_url(url);
+    ResourceResponse response(css_url);
+    response.SetMimeType("text/css");
+
+    CSSStyleSheetResource* css_resource =
+        CSSStyleSheetResource::CreateForTest(css_url, UTF8Encoding());
+    css_resource->ResponseReceived(response);
+    css_resource->AppendData(sheet_text, strlen(sheet_text));
+    css_resource->FinishForTest();
+
+    auto* parser_context = MakeGarbageCollected<CSSParserContext>(
+        MakeGarbageCollected<CSSParserContext>(
+            kHTMLStandardMode, SecureContextMode::kInsecureContext),
+        css_url, true /* origin_clean */,
+        network::mojom::ReferrerPolicy::kDefault, UTF8Encoding(), nullptr);
+    auto* contents =
+        MakeGarbageCollected<StyleSheetContents>(parser_context, url);
+    contents->ParseAuthorStyleSheet(css_resource, nullptr);
+    return contents;
+  }
+
   Persistent<MemoryCache> original_memory_cache_;
 };
 
@@ -177,5 +202,52 @@ TEST_F(CSSStyleSheetResourceTest,
   EXPECT_FALSE(parsed_stylesheet->HasRuleSet());
 }
 
+TEST_F(CSSStyleSheetResourceTest, ParsedRulesSharedAcrossURLs) {
+  ScopedStyleSheetContentsCacheForTest scoped_feature(true);
+  StyleSheetContentsCache& cache = StyleSheetContentsCache::Instance();
+  cache.Clear();
+
+  const char kSheetText[] = "div { color: red } @media print { p { top: 0 } }";
+  StyleSheetContents* contents =
+      ParseAuthorStyleSheet("https://a.test/style.css", kSheetText);
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_EQ(1u, cache.MissCount());
+
+  StyleSheetContents* other_contents =
+      ParseAuthorStyleSheet("https://b.test/style.css", kSheetText);
+  EXPECT_EQ(1u, cache.HitCount());
+  ASSERT_EQ(2u, other_contents->RuleCount());
+  EXPECT_EQ(contents->RuleAt(0), other_contents->RuleAt(0));
+  EXPECT_TRUE(other_contents->HasMediaQueries());
+  EXPECT_TRUE(other_contents->IsUsedFromTextCache());
+  EXPECT_EQ("https://b.test/style.css", other_contents->OriginalURL());
+  EXPECT_EQ(KURL("https://b.test/style.css"), other_contents->BaseURL());
+
+  cache.Clear();
+}
+
+TEST_F(CSSStyleSheetResourceTest, URLDependentRulesNotSharedAcrossURLs) {
+  ScopedStyleSheetContentsCacheForTest scoped_feature(true);
+  StyleSheetContentsCache& cache = StyleSheetContentsCache::Instance();
+  cache.Clear();
+
+  const char kSheetText[] = "div { background: url(image.png) }";
+  StyleSheetContents* contents =
+      ParseAuthorStyleSheet("https://a.test/style.css", kSheetText);
+  StyleSheetContents* other_contents =
+      ParseAuthorStyleSheet("https://b.test/style.css", kSheetText);
+  EXPECT_EQ(0u, cache.HitCount());
+  EXPECT_EQ(2u, cache.MissCount());
+  ASSERT_EQ(1u, other_contents->RuleCount());
+  EXPECT_NE(contents->RuleAt(0), other_contents->RuleAt(0));
+
+  StyleSheetContents* same_url_contents =
+      ParseAuthorStyleSheet("https://b.test/style.css", kSheetText);
+  EXPECT_EQ(1u, cache.HitCount());
+  EXPECT_EQ(other_contents->RuleAt(0), same_url_contents->RuleAt(0));
+
+  cache.Clear();
+}
+
 }  // namespace
 }  // namespace blink
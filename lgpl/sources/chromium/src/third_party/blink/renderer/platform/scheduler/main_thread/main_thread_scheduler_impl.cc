@@ -2304,6 +2304,10 @@ bool MainThreadSchedulerImpl::IsBeginMainFrameScheduled() const {
   return any_thread().begin_main_frame_scheduled_count.value() > 0;
 }
 
+base::TimeTicks MainThreadSchedulerImpl::EstimatedNextFrameBegin() const {
+  return main_thread_only().estimated_next_frame_begin;
+}
+
 void MainThreadSchedulerImpl::RunIdleTask(Thread::IdleTask task,
                                           base::TimeTicks deadline) {
   std::move(task).Run(deadline);
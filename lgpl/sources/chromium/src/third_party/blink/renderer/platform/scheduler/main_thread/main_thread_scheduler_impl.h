@@ -220,6 +220,7 @@ class PLATFORM_EXPORT MainThreadSchedulerImpl
       WebScopedVirtualTimePauser::VirtualTaskDuration duration) override;
   PendingUserInputInfo GetPendingUserInputInfo() const override;
   bool IsBeginMainFrameScheduled() const override;
+  base::TimeTicks EstimatedNextFrameBegin() const override;
 
   // ThreadScheduler implementation:
   void PostIdleTask(const base::Location&, Thread::IdleTask) override;
@@ -3697,6 +3697,14 @@ TEST_P(MainThreadSchedulerImplTest, IsBeginMainFrameScheduled) {
   EXPECT_FALSE(scheduler_->IsBeginMainFrameScheduled());
 }
 
+TEST_P(MainThreadSchedulerImplTest, EstimatedNextFrameBegin) {
+  EXPECT_TRUE(scheduler_->EstimatedNextFrameBegin().is_null());
+  base::TimeTicks frame_time = Now();
+  DoMainFrame();
+  EXPECT_EQ(frame_time + base::TimeDelta::FromMilliseconds(16),
+            scheduler_->EstimatedNextFrameBegin());
+}
+
 class VeryHighPriorityForCompositingAlwaysExperimentTest
     : public MainThreadSchedulerImplTest {
  public:
@@ -136,6 +136,13 @@ class PLATFORM_EXPORT ThreadScheduler {
   // running on the compositor thread.
   virtual bool IsBeginMainFrameScheduled() const { return false; }
 
+  // Returns the time at which the next BeginMainFrame is expected to start,
+  // estimated from the arguments of the last one. Returns a null or past time
+  // when no frame is expected.
+  virtual base::TimeTicks EstimatedNextFrameBegin() const {
+    return base::TimeTicks();
+  }
+
   // Associates |isolate| to the scheduler.
   virtual void SetV8Isolate(v8::Isolate* isolate) = 0;
 
@@ -115,6 +115,30 @@ class PLATFORM_EXPORT SegmentedSubstring {
     --length_;
   }
 
+  // Skips |count| characters, leaving at least one in the substring.
+  ALWAYS_INLINE void AdvanceWithinSubstring(int count) {
+    DCHECK_GE(count, 0);
+    DCHECK_LT(count, length_);
+    if (is_8bit_) {
+      data_.string8_ptr += count;
+      current_char_ = *data_.string8_ptr;
+    } else {
+      data_.string16_ptr += count;
+      current_char_ = *data_.string16_ptr;
+    }
+    length_ -= count;
+  }
+
+  bool Is8Bit() const { return is_8bit_; }
+  const LChar* CurrentCharacters8() const {
+    DCHECK(is_8bit_);
+    return data_.string8_ptr;
+  }
+  const UChar* CurrentCharacters16() const {
+    DCHECK(!is_8bit_);
+    return data_.string16_ptr;
+  }
+
   String CurrentSubString(unsigned length) {
     int offset = string_.length() - length_;
     return string_.Substring(offset, length);
@@ -253,6 +277,31 @@ class PLATFORM_EXPORT SegmentedString {
   // have space for at least |count| characters.
   void Advance(unsigned count, UChar* consumed_characters);
 
+  // Direct access to the unconsumed characters of the current substring, so
+  // that tokenizers can scan runs of ordinary characters in bulk.
+  bool CurrentSubstringIs8Bit() const { return current_string_.Is8Bit(); }
+  const LChar* CurrentSubstringCharacters8() const {
+    return current_string_.CurrentCharacters8();
+  }
+  const UChar* CurrentSubstringCharacters16() const {
+    return current_string_.CurrentCharacters16();
+  }
+  unsigned CurrentSubstringLength() const { return current_string_.length(); }
+
+  // Skips |count| characters of the current substring, none of which may be a
+  // newline. At least one character must be left in the substring, so that
+  // the caller's next Advance() deals with moving on to the next one.
+  ALWAYS_INLINE void AdvancePastNonNewlinesInCurrentSubstring(unsigned count) {
+#if DCHECK_IS_ON()
+    for (unsigned i = 0; i < count; ++i) {
+      DCHECK_NE('\n', current_string_.Is8Bit()
+                          ? current_string_.CurrentCharacters8()[i]
+                          : current_string_.CurrentCharacters16()[i]);
+    }
+#endif
+    current_string_.AdvanceWithinSubstring(count);
+  }
+
   int NumberOfCharactersConsumed() const {
     int number_of_pushed_characters = 0;
     return number_of_characters_consumed_prior_to_current_string_ +